@@ -0,0 +1,191 @@
+#include "../src/builder.h"
+#include "../src/epsnfa.h"
+
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// NOTE: differential check of AutomatonBuilder. Random edits are applied to
+// builder and after some of them its compiled and minimized tables must be
+// the same as the ones rebuilt from scratch out of edited table: rows are
+// unions over epsilon closures and minimized table keeps reachable states
+
+using States = std::unordered_set<State>;
+
+static const State STATES = 12;
+static const char CHARACTERS[] = {'a', 'b', 'c'};
+
+static void Check(bool condition, const char *what, std::size_t iteration) {
+  if (!condition) {
+    std::fprintf(stderr, "builder check: %s at edit %zu\n", what, iteration);
+    std::abort();
+  }
+}
+
+static States Closure(MovesTable &table, State state) {
+  States closure{state};
+  std::vector<State> unprocessed{state};
+
+  while (!unprocessed.empty()) {
+    State current = unprocessed.back();
+    unprocessed.pop_back();
+
+    for (State next_state :
+         table.GetNextStates(current, ENFA::EPS_CHARACTER)) {
+      if (closure.insert(next_state).second) {
+        unprocessed.push_back(next_state);
+      }
+    }
+  }
+
+  return closure;
+}
+
+static MovesTable Compile(MovesTable table) {
+  MovesTable compiled;
+
+  for (const auto &[state, moves] : table) {
+    auto &row = compiled[state];
+    bool is_final = false;
+
+    for (State closure_state : Closure(table, state)) {
+      is_final = is_final || table.IsFinal(closure_state);
+
+      for (const auto &[character, next_states] : table[closure_state]) {
+        if (character != ENFA::EPS_CHARACTER) {
+          row[character].insert(next_states.begin(), next_states.end());
+        }
+      }
+    }
+
+    compiled.SetInitial(state, table.IsInitial(state));
+    compiled.SetFinal(state, is_final);
+  }
+
+  return compiled;
+}
+
+static MovesTable Minimize(MovesTable compiled) {
+  MovesTable minimized;
+  std::vector<State> unprocessed;
+
+  for (const auto &[state, moves] : compiled) {
+    if (compiled.IsInitial(state)) {
+      unprocessed.push_back(state);
+    }
+  }
+
+  while (!unprocessed.empty()) {
+    State current = unprocessed.back();
+    unprocessed.pop_back();
+
+    if (minimized.ContainsState(current) || !compiled.ContainsState(current)) {
+      continue;
+    }
+
+    minimized[current] = compiled[current];
+    minimized.SetInitial(current, compiled.IsInitial(current));
+    minimized.SetFinal(current, compiled.IsFinal(current));
+
+    for (const auto &[character, next_states] : compiled[current]) {
+      unprocessed.insert(unprocessed.end(), next_states.begin(),
+                         next_states.end());
+    }
+  }
+
+  return minimized;
+}
+
+// NOTE: empty rows of characters are the same as missing ones
+static bool Same(MovesTable first, MovesTable second) {
+  if (first.Size() != second.Size()) {
+    return false;
+  }
+
+  for (const auto &[state, moves] : first) {
+    if (!second.ContainsState(state) ||
+        first.IsInitial(state) != second.IsInitial(state) ||
+        first.IsFinal(state) != second.IsFinal(state)) {
+      return false;
+    }
+
+    for (char character : CHARACTERS) {
+      if (first.GetNextStates(state, character) !=
+          second.GetNextStates(state, character)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+// NOTE: usage: automaton_builder [edits] [seed]
+int main(int argc, char **argv) {
+  std::size_t edits = 20000;
+  unsigned seed = 42;
+  if (argc > 1) {
+    std::from_chars(argv[1], argv[1] + std::strlen(argv[1]), edits);
+  }
+  if (argc > 2) {
+    std::from_chars(argv[2], argv[2] + std::strlen(argv[2]), seed);
+  }
+
+  std::mt19937 random(seed);
+  auto below = [&](std::size_t bound) { return random() % bound; };
+  auto character = [&] {
+    return below(4) ? CHARACTERS[below(std::size(CHARACTERS))]
+                    : ENFA::EPS_CHARACTER;
+  };
+
+  AutomatonBuilder builder;
+
+  for (std::size_t edit = 0; edit < edits; ++edit) {
+    // NOTE: automaton is started anew from time to time, so that edits are
+    // made to small automata as well as to dense ones
+    if (below(500) == 0) {
+      builder = AutomatonBuilder();
+    }
+
+    State state = static_cast<State>(below(STATES));
+
+    switch (below(8)) {
+    case 0:
+    case 1:
+    case 2:
+      builder.AddMove(state, character(),
+                      {static_cast<State>(below(STATES)),
+                       static_cast<State>(below(STATES))});
+      break;
+    case 3:
+      builder.RemoveMove(state, character(),
+                         {static_cast<State>(below(STATES))});
+      break;
+    case 4:
+      builder.RemoveState(state);
+      break;
+    case 5:
+      builder.SetInitial(state, below(2));
+      break;
+    case 6:
+      builder.SetFinal(state, below(2));
+      break;
+    case 7:
+      builder.Closure(state);
+      break;
+    }
+
+    if (below(3) == 0) {
+      MovesTable compiled = Compile(builder.GetMovesTable());
+      Check(Same(builder.Compile(), compiled), "compiled table", edit);
+      Check(Same(builder.Minimize(), Minimize(compiled)), "minimized table",
+            edit);
+    }
+  }
+
+  std::cout << edits << " edits passed\n";
+}
@@ -3,9 +3,19 @@
 #include <fstream>
 #include <nlohmann/json.hpp>
 
+// NOTE: ids are checked before conversion, since the json ones are not
+// limited to State and would be truncated silently
+static State StateId(const nlohmann::json &id) {
+  if (!id.is_number_unsigned() ||
+      id.get<std::uint64_t>() > MovesTable::MAX_STATE) {
+    throw "Exception: State id is out of range";
+  }
+  return id.get<State>();
+}
+
 Automaton::Automaton(MovesTable &&table) : moves_table(std::move(table)) {
   for (const auto &[state, dict] : moves_table) {
-    if (state.is_initial) {
+    if (moves_table.IsInitial(state)) {
       current_states.insert(state);
     }
   }
@@ -18,27 +28,25 @@ Automaton::Automaton(const std::filesystem::path &file) {
     return;
   }
 
-  std::unordered_map<size_t, State> states;
-
   auto json_moves = nlohmann::json::parse(in);
 
   in.close();
 
   for (auto json_state : json_moves) {
-    State source_state{json_state.at("source_state"),
-                       json_state.at("is_initial_state"),
-                       json_state.at("is_final_state")};
-    states[source_state.id] = source_state;
+    State source_state = StateId(json_state.at("source_state"));
+
+    moves_table.SetInitial(source_state, json_state.at("is_initial_state"));
+    moves_table.SetFinal(source_state, json_state.at("is_final_state"));
 
-    if (source_state.is_initial) {
+    if (moves_table.IsInitial(source_state)) {
       current_states.insert(source_state);
     }
   }
 
   for (auto json_state : json_moves) {
-    size_t id = json_state.at("source_state");
+    State id = StateId(json_state.at("source_state"));
 
-    moves_table.AddMoveToState(states[id], '\0', {});
+    moves_table.AddMoveToState(id, '\0', {});
 
     for (auto json_move : json_state.at("moves")) {
       std::string character = json_move.at("character");
@@ -46,10 +54,10 @@ Automaton::Automaton(const std::filesystem::path &file) {
       std::unordered_set<State> next_states;
 
       for (auto json_next_state_id : json_move.at("next_states")) {
-        next_states.insert(states[static_cast<size_t>(json_next_state_id)]);
+        next_states.insert(StateId(json_next_state_id));
       }
 
-      moves_table.AddMoveToState(states[id], character[0], next_states);
+      moves_table.AddMoveToState(id, character[0], next_states);
     }
   }
 }
@@ -75,7 +83,7 @@ bool Automaton::Next(char character) const {
 
 bool Automaton::IsFinal() const {
   for (auto state : current_states) {
-    if (state.is_final) {
+    if (moves_table.IsFinal(state)) {
       return true;
     }
   }
@@ -0,0 +1,323 @@
+#include "builder.h"
+#include "epsnfa.h"
+#include "nfa.h"
+
+#include <vector>
+
+using States = std::unordered_set<State>;
+
+AutomatonBuilder::AutomatonBuilder(const MovesTable &source) : table(source) {
+  for (const auto &[state, moves] : table) {
+    dirty.insert(state);
+
+    for (const auto &[character, next_states] : moves) {
+      for (const auto &next_state : next_states) {
+        predecessors[next_state].insert(state);
+
+        if (character == ENFA::EPS_CHARACTER) {
+          eps_predecessors[next_state].insert(state);
+        }
+      }
+    }
+  }
+}
+
+void AutomatonBuilder::Invalidate(State state) {
+  // NOTE: closure (and compiled row) of every state reaching `state` by
+  // epsilon moves depends on it
+  std::vector<State> unprocessed{state};
+  States visited{state};
+
+  while (!unprocessed.empty()) {
+    State current = unprocessed.back();
+    unprocessed.pop_back();
+
+    closures.erase(current);
+    dirty.insert(current);
+
+    if (!eps_predecessors.contains(current)) {
+      continue;
+    }
+
+    for (State predecessor : eps_predecessors.at(current)) {
+      if (visited.insert(predecessor).second) {
+        unprocessed.push_back(predecessor);
+      }
+    }
+  }
+}
+
+void AutomatonBuilder::AddState(State state) {
+  if (!table.ContainsState(state)) {
+    table.AddMoveToState(state, '\0', {});
+    dirty.insert(state);
+  }
+}
+
+void AutomatonBuilder::AddMove(State state, char character,
+                               const States &next_states) {
+  AddState(state);
+
+  if (!character) {
+    return;
+  }
+
+  for (State next_state : next_states) {
+    AddState(next_state);
+
+    predecessors[next_state].insert(state);
+
+    if (character == ENFA::EPS_CHARACTER) {
+      eps_predecessors[next_state].insert(state);
+    }
+  }
+
+  table.AddMoveToState(state, character, next_states);
+
+  Invalidate(state);
+}
+
+void AutomatonBuilder::RemoveMove(State state, char character,
+                                  const States &next_states) {
+  if (!table.ContainsState(state)) {
+    return;
+  }
+
+  table.RemoveMoveFromState(state, character, next_states);
+
+  for (State next_state : next_states) {
+    bool still_connected = false;
+
+    for (const auto &[other_character, other_next_states] : table[state]) {
+      if (other_next_states.contains(next_state)) {
+        still_connected = true;
+        break;
+      }
+    }
+
+    if (!still_connected) {
+      predecessors[next_state].erase(state);
+    }
+
+    if (character == ENFA::EPS_CHARACTER) {
+      eps_predecessors[next_state].erase(state);
+    }
+  }
+
+  Invalidate(state);
+}
+
+void AutomatonBuilder::RemoveState(State state) {
+  if (!table.ContainsState(state)) {
+    return;
+  }
+
+  Invalidate(state);
+
+  // NOTE: state may be added again before Compile, then its row is compiled
+  // anew and would not tell that it was cut out
+  if (table.IsInitial(state) || reachable.contains(state)) {
+    reachability_stale = true;
+  }
+  reachable.erase(state);
+  pending_reachable.erase(state);
+
+  if (predecessors.contains(state)) {
+    for (State predecessor : predecessors.at(state)) {
+      Invalidate(predecessor);
+
+      for (auto &[character, next_states] : table[predecessor]) {
+        next_states.erase(state);
+      }
+    }
+  }
+
+  for (const auto &[character, next_states] : table[state]) {
+    for (State next_state : next_states) {
+      predecessors[next_state].erase(state);
+      eps_predecessors[next_state].erase(state);
+    }
+  }
+
+  predecessors.erase(state);
+  eps_predecessors.erase(state);
+  closures.erase(state);
+
+  table.RemoveState(state);
+}
+
+void AutomatonBuilder::SetInitial(State state, bool is_initial) {
+  AddState(state);
+
+  table.SetInitial(state, is_initial);
+  dirty.insert(state);
+
+  if (is_initial) {
+    pending_reachable.insert(state);
+  } else {
+    reachability_stale = true;
+  }
+}
+
+void AutomatonBuilder::SetFinal(State state, bool is_final) {
+  AddState(state);
+
+  table.SetFinal(state, is_final);
+  Invalidate(state);
+}
+
+const States &AutomatonBuilder::Closure(State state) {
+  if (auto cached = closures.find(state); cached != closures.end()) {
+    return cached->second;
+  }
+
+  States closure{state};
+  std::vector<State> unprocessed{state};
+
+  while (!unprocessed.empty()) {
+    State current = unprocessed.back();
+    unprocessed.pop_back();
+
+    for (State next_state :
+         table.GetNextStates(current, ENFA::EPS_CHARACTER)) {
+      if (closure.insert(next_state).second) {
+        unprocessed.push_back(next_state);
+      }
+    }
+  }
+
+  return closures[state] = std::move(closure);
+}
+
+void AutomatonBuilder::CompileState(State state) {
+  if (!table.ContainsState(state)) {
+    if (compiled.ContainsState(state)) {
+      compiled.RemoveState(state);
+      reachability_stale = true;
+    }
+    return;
+  }
+
+  std::unordered_map<char, States> row;
+  bool is_final = false;
+
+  for (State closure_state : Closure(state)) {
+    is_final = is_final || table.IsFinal(closure_state);
+
+    for (const auto &[character, next_states] : table[closure_state]) {
+      if (character != ENFA::EPS_CHARACTER) {
+        row[character].insert(next_states.begin(), next_states.end());
+      }
+    }
+  }
+
+  auto &compiled_row = compiled[state];
+
+  // NOTE: growing row can only extend reachable set, shrinking one may cut it
+  bool shrunk = false;
+  for (const auto &[character, next_states] : compiled_row) {
+    for (State next_state : next_states) {
+      if (!(row.contains(character) && row[character].contains(next_state))) {
+        shrunk = true;
+        break;
+      }
+    }
+  }
+
+  if (shrunk) {
+    reachability_stale = true;
+  } else if (reachable.contains(state)) {
+    for (const auto &[character, next_states] : row) {
+      pending_reachable.insert(next_states.begin(), next_states.end());
+    }
+  }
+
+  compiled_row = std::move(row);
+  compiled.SetInitial(state, table.IsInitial(state));
+  compiled.SetFinal(state, is_final);
+}
+
+void AutomatonBuilder::UpdateReachability(const States &changed) {
+  States affected = changed;
+
+  if (reachability_stale) {
+    for (State state : reachable) {
+      affected.insert(state);
+    }
+
+    reachable.clear();
+    pending_reachable.clear();
+
+    for (const auto &[state, moves] : compiled) {
+      if (compiled.IsInitial(state)) {
+        pending_reachable.insert(state);
+      }
+    }
+  }
+
+  std::vector<State> unprocessed(pending_reachable.begin(),
+                                 pending_reachable.end());
+  pending_reachable.clear();
+
+  while (!unprocessed.empty()) {
+    State current = unprocessed.back();
+    unprocessed.pop_back();
+
+    if (!compiled.ContainsState(current) || !reachable.insert(current).second) {
+      continue;
+    }
+
+    affected.insert(current);
+
+    for (const auto &[character, next_states] : compiled[current]) {
+      unprocessed.insert(unprocessed.end(), next_states.begin(),
+                         next_states.end());
+    }
+  }
+
+  for (State state : affected) {
+    if (reachable.contains(state)) {
+      minimized[state] = compiled[state];
+      minimized.SetInitial(state, compiled.IsInitial(state));
+      minimized.SetFinal(state, compiled.IsFinal(state));
+    } else if (minimized.ContainsState(state)) {
+      minimized.RemoveState(state);
+    }
+  }
+
+  reachability_stale = false;
+}
+
+const MovesTable &AutomatonBuilder::Compile() {
+  if (dirty.empty() && pending_reachable.empty() && !reachability_stale) {
+    return compiled;
+  }
+
+  States changed = std::move(dirty);
+  dirty.clear();
+
+  for (State state : changed) {
+    CompileState(state);
+  }
+
+  UpdateReachability(changed);
+
+  return compiled;
+}
+
+const MovesTable &AutomatonBuilder::Minimize() {
+  Compile();
+  return minimized;
+}
+
+const MovesTable &AutomatonBuilder::GetMovesTable() const noexcept {
+  return table;
+}
+
+AutomatonBuilder::operator EpsNondeterministicFiniteAutomaton() {
+  return ENFA(MovesTable(table));
+}
+
+AutomatonBuilder::operator NondeterministicFiniteAutomaton() {
+  return NFA(MovesTable(Minimize()));
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "movestable.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+class NondeterministicFiniteAutomaton;
+class EpsNondeterministicFiniteAutomaton;
+
+// NOTE: editable automaton which keeps epsilon closures, the eps-free
+// (compiled) table and its minimized form up to date. Every edit marks only
+// the states whose derived rows depend on it, Compile() re-derives just them.
+class AutomatonBuilder {
+private:
+  using States = std::unordered_set<State>;
+
+  MovesTable table;
+  MovesTable compiled;
+  MovesTable minimized;
+
+  std::unordered_map<State, States> predecessors;
+  std::unordered_map<State, States> eps_predecessors;
+  std::unordered_map<State, States> closures;
+
+  States dirty;
+  States reachable;
+  States pending_reachable;
+  bool reachability_stale = true;
+
+public:
+  AutomatonBuilder() = default;
+  AutomatonBuilder(const MovesTable &source);
+
+  void AddMove(State state, char character, const States &next_states);
+  void RemoveMove(State state, char character, const States &next_states);
+  void RemoveState(State state);
+  void SetInitial(State state, bool is_initial = true);
+  void SetFinal(State state, bool is_final = true);
+
+  const States &Closure(State state);
+  const MovesTable &Compile();
+  const MovesTable &Minimize();
+
+  const MovesTable &GetMovesTable() const noexcept;
+
+  operator EpsNondeterministicFiniteAutomaton();
+  operator NondeterministicFiniteAutomaton();
+
+private:
+  void Invalidate(State state);
+  void AddState(State state);
+  void CompileState(State state);
+  void UpdateReachability(const States &changed);
+};
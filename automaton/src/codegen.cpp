@@ -0,0 +1,251 @@
+#include "codegen.h"
+
+#include <cctype>
+#include <cstdio>
+#include <map>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct DenseAutomaton {
+  std::vector<State> states;
+  std::vector<std::map<char, size_t>> moves;
+  std::vector<bool> is_final;
+};
+
+} // namespace
+
+static std::string Identifier(const std::string &stem) {
+  std::string identifier;
+
+  for (char ch : stem) {
+    identifier += std::isalnum(static_cast<unsigned char>(ch)) ? ch : '_';
+  }
+
+  if (identifier.empty() ||
+      std::isdigit(static_cast<unsigned char>(identifier[0]))) {
+    identifier.insert(0, "dfa_");
+  }
+
+  return identifier;
+}
+
+static std::string CharLiteral(char character) {
+  if (std::isprint(static_cast<unsigned char>(character)) &&
+      character != '\'' && character != '\\') {
+    return {'\'', character, '\''};
+  }
+
+  char buffer[8];
+  std::snprintf(buffer, sizeof(buffer), "'\\x%02x'",
+                static_cast<unsigned char>(character));
+  return buffer;
+}
+
+// NOTE: renumbers states reachable from the initial one densely in BFS order,
+// so initial state always gets index 0
+static DenseAutomaton Densify(const MovesTable &table) {
+  std::vector<State> initial_states;
+
+  for (const auto &[state, moves] : table) {
+    if (table.IsInitial(state)) {
+      initial_states.push_back(state);
+    }
+  }
+
+  if (initial_states.size() != 1) {
+    throw "Exception: Automaton must have exactly one initial state";
+  }
+
+  std::unordered_map<State, std::map<char, State>> moves_of;
+
+  for (const auto &[state, dict] : table) {
+    auto &moves = moves_of[state];
+
+    for (const auto &[character, next_states] : dict) {
+      if (next_states.size() > 1) {
+        throw "Exception: Automaton is not deterministic";
+      }
+
+      if (!next_states.empty()) {
+        moves[character] = *next_states.begin();
+      }
+    }
+  }
+
+  DenseAutomaton dense;
+  std::unordered_map<State, size_t> index{{initial_states.front(), 0}};
+  std::queue<State> unprocessed;
+
+  dense.states.push_back(initial_states.front());
+  unprocessed.push(initial_states.front());
+
+  while (!unprocessed.empty()) {
+    State state = unprocessed.front();
+    unprocessed.pop();
+
+    std::map<char, size_t> dense_moves;
+
+    for (const auto &[character, next_state] : moves_of[state]) {
+      if (!index.contains(next_state)) {
+        index[next_state] = dense.states.size();
+        dense.states.push_back(next_state);
+        unprocessed.push(next_state);
+      }
+      dense_moves[character] = index[next_state];
+    }
+
+    dense.moves.push_back(std::move(dense_moves));
+    dense.is_final.push_back(table.IsFinal(state));
+  }
+
+  return dense;
+}
+
+static void GenerateHeader(const std::string &name, std::ostream &header) {
+  header << "// Generated by automaton --emit-cpp, do not edit.\n"
+            "#pragma once\n"
+            "\n"
+            "#include <string_view>\n"
+            "\n"
+            "namespace "
+         << name
+         << " {\n"
+            "\n"
+            "bool InLanguage(std::string_view word);\n"
+            "\n"
+            "} // namespace "
+         << name << "\n";
+}
+
+static void GenerateSwitch(const DenseAutomaton &dense, std::ostream &source) {
+  source << "bool InLanguage(std::string_view word) {\n"
+            "  const char *current = word.data();\n"
+            "  const char *const end = current + word.size();\n";
+
+  std::vector<bool> is_target(dense.states.size(), false);
+  for (const auto &moves : dense.moves) {
+    for (const auto &[character, next_state] : moves) {
+      is_target[next_state] = true;
+    }
+  }
+
+  for (size_t i = 0; i < dense.states.size(); ++i) {
+    const char *verdict = dense.is_final[i] ? "true" : "false";
+
+    source << '\n';
+    if (is_target[i]) {
+      source << "state_" << dense.states[i] << ":\n";
+    }
+
+    if (dense.moves[i].empty()) {
+      source << "  return " << (dense.is_final[i] ? "current == end" : "false")
+             << ";\n";
+      continue;
+    }
+
+    source << "  if (current == end) {\n"
+              "    return "
+           << verdict
+           << ";\n"
+              "  }\n"
+              "  switch (*current++) {\n";
+
+    for (const auto &[character, next_state] : dense.moves[i]) {
+      source << "  case " << CharLiteral(character) << ":\n"
+             << "    goto state_" << dense.states[next_state] << ";\n";
+    }
+
+    source << "  default:\n"
+              "    return false;\n"
+              "  }\n";
+  }
+
+  source << "}\n";
+}
+
+static void GenerateTable(const DenseAutomaton &dense, std::ostream &source) {
+  const char *index_type =
+      dense.states.size() < 0x7fff ? "std::int16_t" : "std::int32_t";
+
+  source << "namespace {\n"
+            "\n"
+            "constexpr "
+         << index_type
+         << " DEAD = -1;\n"
+            "\n"
+            "constexpr "
+         << index_type << " MOVES[" << dense.states.size() << "][256] = {\n";
+
+  for (size_t i = 0; i < dense.states.size(); ++i) {
+    std::vector<long> row(256, -1);
+
+    for (const auto &[character, next_state] : dense.moves[i]) {
+      row[static_cast<unsigned char>(character)] = static_cast<long>(next_state);
+    }
+
+    source << "    // state " << dense.states[i] << "\n    {";
+
+    for (size_t ch = 0; ch < row.size(); ++ch) {
+      source << (ch == 0 ? "" : ch % 16 == 0 ? ",\n     " : ", ") << row[ch];
+    }
+
+    source << "},\n";
+  }
+
+  source << "};\n"
+            "\n"
+            "constexpr bool FINAL["
+         << dense.states.size() << "] = {";
+
+  for (size_t i = 0; i < dense.states.size(); ++i) {
+    source << (i == 0 ? "" : ", ") << (dense.is_final[i] ? "true" : "false");
+  }
+
+  source << "};\n"
+            "\n"
+            "} // namespace\n"
+            "\n"
+            "bool InLanguage(std::string_view word) {\n"
+            "  "
+         << index_type
+         << " state = 0;\n"
+            "\n"
+            "  for (unsigned char ch : word) {\n"
+            "    state = MOVES[state][ch];\n"
+            "    if (state == DEAD) {\n"
+            "      return false;\n"
+            "    }\n"
+            "  }\n"
+            "\n"
+            "  return FINAL[state];\n"
+            "}\n";
+}
+
+void GenerateCpp(const MovesTable &table, const std::string &stem,
+                 CppStyle style, std::ostream &header, std::ostream &source) {
+  DenseAutomaton dense = Densify(table);
+  std::string name = Identifier(stem);
+
+  GenerateHeader(name, header);
+
+  source << "// Generated by automaton --emit-cpp, do not edit.\n"
+            "#include \""
+         << stem << ".h\"\n";
+
+  if (style == CppStyle::TABLE) {
+    source << "\n#include <cstdint>\n";
+  }
+
+  source << "\nnamespace " << name << " {\n\n";
+
+  if (style == CppStyle::SWITCH) {
+    GenerateSwitch(dense, source);
+  } else {
+    GenerateTable(dense, source);
+  }
+
+  source << "\n} // namespace " << name << "\n";
+}
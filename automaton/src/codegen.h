@@ -0,0 +1,13 @@
+#pragma once
+
+#include "movestable.h"
+
+#include <ostream>
+#include <string>
+
+enum class CppStyle { SWITCH, TABLE };
+
+// NOTE: writes standalone matcher `bool <stem>::InLanguage(std::string_view)`
+// for deterministic table; header is expected to be saved as <stem>.h
+void GenerateCpp(const MovesTable &table, const std::string &stem,
+                 CppStyle style, std::ostream &header, std::ostream &source);
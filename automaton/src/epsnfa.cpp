@@ -67,7 +67,7 @@ static void Minimize(MovesTable &table) {
   States unreachable;
 
   for (const auto &[state, moves] : table) {
-    if (!(IsReachable(state, table) || state.is_initial)) {
+    if (!(IsReachable(state, table) || table.IsInitial(state))) {
       unreachable.insert(state);
     }
   }
@@ -84,16 +84,17 @@ ENFA::operator NondeterministicFiniteAutomaton() {
 
   for (const auto &[state, moves] : moves_table) {
     States closure = Closure({state});
-    State source_state = state;
+
+    nfa_moves_table.SetInitial(state, moves_table.IsInitial(state));
 
     for (const State &closure_state : closure) {
-      if (closure_state.is_final) {
-        source_state.is_final = true;
+      if (moves_table.IsFinal(closure_state)) {
+        nfa_moves_table.SetFinal(state);
         break;
       }
     }
 
-    nfa_moves_table.AddMoveToState(source_state, '\0', {});
+    nfa_moves_table.AddMoveToState(state, '\0', {});
   }
 
   for (const auto &[state, moves] : moves_table) {
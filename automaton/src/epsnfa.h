@@ -32,4 +32,5 @@ public:
 
   friend class NondeterministicFiniteAutomaton;
   friend class DeterministicFiniteAutomaton;
+  friend class AutomatonBuilder;
 };
@@ -18,10 +18,8 @@ JoinMovesByCharacter(MovesTable &table,
   return merged_moves_by_character;
 }
 
-State CombineStates(
-    const std::unordered_set<State> &states,
-    std::unordered_map<std::unordered_set<State>, State> &mapping,
-    MovesTable &table) {
+State CombineStates(const std::unordered_set<State> &states,
+                    StatesMapping &mapping, MovesTable &table) {
   if (mapping.contains(states)) {
     return mapping[states];
   } else if (states.size() == 1) {
@@ -29,17 +27,11 @@ State CombineStates(
 
     return *states.begin();
   } else {
-    State new_state{mapping.size(), false, false};
+    State new_state;
     do {
-      new_state.id = static_cast<size_t>(std::rand()) % (table.Size() * 10);
+      new_state = static_cast<State>(std::rand()) % (table.Size() * 10);
     } while (table.ContainsState(new_state));
 
-    for (const auto &state : states) {
-      if (state.is_final) {
-        new_state.is_final = true;
-      }
-    }
-
     mapping[states] = new_state;
 
     return new_state;
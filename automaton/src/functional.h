@@ -2,7 +2,7 @@
 #include "state.h"
 #include <unordered_set>
 
-template <> struct std::hash<std::unordered_set<State>> {
+struct StatesHash {
   std::size_t operator()(const std::unordered_set<State> &value) const {
     const std::size_t prime = 19937;
     const std::hash<State> hash;
@@ -14,11 +14,12 @@ template <> struct std::hash<std::unordered_set<State>> {
   }
 };
 
+using StatesMapping =
+    std::unordered_map<std::unordered_set<State>, State, StatesHash>;
+
 std::unordered_map<char, std::unordered_set<State>>
 JoinMovesByCharacter(MovesTable &table,
                      const std::unordered_set<State> &states);
 
-State CombineStates(
-    const std::unordered_set<State> &states,
-    std::unordered_map<std::unordered_set<State>, State> &mapping,
-    MovesTable &table);
+State CombineStates(const std::unordered_set<State> &states,
+                    StatesMapping &mapping, MovesTable &table);
@@ -5,7 +5,7 @@
 void Log(const std::unordered_set<State> &states) {
   std::cerr << "States: ";
   for (auto state : states) {
-    std::cerr << ' ' << state.id;
+    std::cerr << ' ' << state;
   }
   std::cerr << std::endl;
 }
@@ -1,14 +1,17 @@
 #define DEBUG
 
 #include "automaton.h"
+#include "codegen.h"
 #include "dfa.h"
 #include "epsnfa.h"
 #include "nfa.h"
 #include "out.h"
 
 #include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <queue>
+#include <sstream>
 
 const std::string PATH_TO_CURRENT_AUTOMAT =
     "/home/sharovkv/Projects/University/"
@@ -54,6 +57,8 @@ void PrintHelp(const std::string &) {
          "to load automaton\n"
          "\t-P, --print-automaton\t\t\t\tshow table of automaton states and "
          "moves\n"
+         "\t--print-automaton-as <format>\t\t\tprint automaton as table, "
+         "csv, dot or json (json is loadable with -A)\n"
          "\t-W, --word <word>\t\t\t\tverificate the <word> with a "
          "current/given "
          "automaton; outputs response to stdout and details to stderr\n"
@@ -62,7 +67,12 @@ void PrintHelp(const std::string &) {
          "\t--convert-to-nfa\t\t\t\tconvert current automaton to "
          "nondeterministic\n"
          "\t--convert-to-dfa\t\t\t\tconvert current automaton to "
-         "nondeterministic with epsilon moves\n";
+         "nondeterministic with epsilon moves\n"
+         "\t--emit-cpp <path/to/name>\t\t\tgenerate <name>.h and "
+         "<name>.cpp with switch-based matcher of current automaton "
+         "(converted to deterministic)\n"
+         "\t--emit-cpp-table <path/to/name>\t\t\tsame as --emit-cpp, "
+         "but matcher uses constexpr moves table\n";
 }
 
 void SetAutomaton(const std::string &path_to_file) {
@@ -74,6 +84,9 @@ void SetAutomaton(const std::string &path_to_file) {
   }
   try {
     std::unique_ptr<Automaton> test = Factory(file);
+  } catch (const char *exception) {
+    std::cerr << "automaton : Error: " << exception << '\n';
+    exit(1);
   } catch (...) {
     std::cerr << "automaton : Error: json parsing error! Invalid file!\n";
     exit(1);
@@ -94,7 +107,20 @@ void SetAutomaton(const std::string &path_to_file) {
   }
 }
 
-void PrintAutomaton(const std::string &) {
+void PrintAutomaton(const std::string &format) {
+  const std::unordered_map<std::string, OutFormat> FORMATS{
+      {"", OutFormat::TABLE},
+      {"table", OutFormat::TABLE},
+      {"csv", OutFormat::CSV},
+      {"dot", OutFormat::DOT},
+      {"json", OutFormat::JSON}};
+
+  if (!FORMATS.contains(format)) {
+    std::cerr << "automaton : Error: unknown output format '" << format
+              << "'!\n";
+    exit(1);
+  }
+
   std::filesystem::path file = FindAutomatonFile();
 
   if (file.empty() || !std::filesystem::exists(file)) {
@@ -105,7 +131,7 @@ void PrintAutomaton(const std::string &) {
   }
 
   std::unique_ptr<Automaton> automaton = Factory(file);
-  Out(std::move(automaton->GetMovesTable()));
+  Out(std::move(automaton->GetMovesTable()), FORMATS.at(format));
 }
 
 void ProcessWord(const std::string &word) {
@@ -152,6 +178,50 @@ template <typename T> void ConvertTo(const std::string &) {
   }
 }
 
+template <CppStyle style> void EmitCpp(const std::string &path) {
+  std::filesystem::path file = FindAutomatonFile();
+
+  if (file.empty()) {
+    std::cerr << "Erorr: automaton does not load!\nPlease use -A "
+                 "<path/to/file> (or "
+                 "--set-automaton <path/to/file>) command beforehand\n";
+    exit(1);
+  }
+
+  std::filesystem::path output = path;
+  // NOTE: code is generated in memory first, so failed generation does not
+  // truncate previously emitted files
+  std::ostringstream header;
+  std::ostringstream source;
+
+  try {
+    MovesTable table;
+    if (file.extension() == ".dfa") {
+      table = DFA(file).GetMovesTable();
+    } else if (file.extension() == ".nfa") {
+      table = DFA(NFA(file)).GetMovesTable();
+    } else if (file.extension() == ".enfa") {
+      table = DFA(ENFA(file)).GetMovesTable();
+    }
+
+    GenerateCpp(table, output.filename().string(), style, header, source);
+  } catch (const char *exception) {
+    std::cerr << "automaton : Error: " << exception << '\n';
+    exit(1);
+  }
+
+  std::ofstream header_file(output.string() + ".h");
+  std::ofstream source_file(output.string() + ".cpp");
+
+  if (!header_file.is_open() || !source_file.is_open()) {
+    std::cerr << "automaton : Error: can not open output files!\n";
+    exit(1);
+  }
+
+  header_file << header.str();
+  source_file << source.str();
+}
+
 struct TaskComparator {
   bool operator()(std::tuple<size_t, Task *, std::string> first,
                   std::tuple<size_t, Task *, std::string> second) {
@@ -174,12 +244,18 @@ int main(int argc, char **argv) {
       tasks.push(std::make_tuple(3U, ProcessWord, ++i != argc ? argv[i] : ""));
     } else if (argv_i == "-P" || argv_i == "--print-automaton") {
       tasks.push(std::make_tuple(2U, PrintAutomaton, ""));
+    } else if (argv_i == "--print-automaton-as" && ++i != argc) {
+      tasks.push(std::make_tuple(2U, PrintAutomaton, argv[i]));
     } else if (argv_i == "--convert-to-dfa") {
       tasks.push(std::make_tuple(4U, ConvertTo<DFA>, ""));
     } else if (argv_i == "--convert-to-nfa") {
       tasks.push(std::make_tuple(4U, ConvertTo<NFA>, ""));
     } else if (argv_i == "--convert-to-enfa") {
       tasks.push(std::make_tuple(4U, ConvertTo<ENFA>, ""));
+    } else if (argv_i == "--emit-cpp" && ++i != argc) {
+      tasks.push(std::make_tuple(5U, EmitCpp<CppStyle::SWITCH>, argv[i]));
+    } else if (argv_i == "--emit-cpp-table" && ++i != argc) {
+      tasks.push(std::make_tuple(5U, EmitCpp<CppStyle::TABLE>, argv[i]));
     } else {
       tasks.push(std::make_tuple(0U, PrintHelp, ""));
     }
@@ -1,5 +1,22 @@
 #include "movestable.h"
 
+static bool Test(const std::vector<bool> &bitmap, State state) noexcept {
+  return state < bitmap.size() && bitmap[state];
+}
+
+static void Assign(std::vector<bool> &bitmap, State state, bool value) {
+  if (state >= bitmap.size()) {
+    if (!value) {
+      return;
+    }
+    if (state > MovesTable::MAX_STATE) {
+      throw "Exception: State id is out of range";
+    }
+    bitmap.resize(static_cast<size_t>(state) + 1, false);
+  }
+  bitmap[state] = value;
+}
+
 void MovesTable::AddMoveToState(State state, char character,
                                 States next_states) {
   if (character) {
@@ -12,7 +29,47 @@ void MovesTable::AddMoveToState(State state, char character,
   }
 }
 
-void MovesTable::RemoveState(State state) { table.erase(state); }
+void MovesTable::RemoveMoveFromState(State state, char character,
+                                     const States &next_states) {
+  if (!table.contains(state)) {
+    return;
+  }
+
+  auto &moves = table[state];
+  if (!moves.contains(character)) {
+    return;
+  }
+
+  for (const auto &next_state : next_states) {
+    moves[character].erase(next_state);
+  }
+
+  if (moves[character].empty()) {
+    moves.erase(character);
+  }
+}
+
+void MovesTable::RemoveState(State state) {
+  table.erase(state);
+  Assign(initial_states, state, false);
+  Assign(final_states, state, false);
+}
+
+bool MovesTable::IsInitial(State state) const noexcept {
+  return Test(initial_states, state);
+}
+
+bool MovesTable::IsFinal(State state) const noexcept {
+  return Test(final_states, state);
+}
+
+void MovesTable::SetInitial(State state, bool is_initial) {
+  Assign(initial_states, state, is_initial);
+}
+
+void MovesTable::SetFinal(State state, bool is_final) {
+  Assign(final_states, state, is_final);
+}
 
 MovesTable::States MovesTable::GetNextStates(State current_state,
                                              char character) const {
@@ -26,11 +83,17 @@ MovesTable::States MovesTable::GetNextStates(State current_state,
 
 MovesTable::Table::iterator MovesTable::begin() { return table.begin(); }
 MovesTable::Table::iterator MovesTable::end() { return table.end(); }
+MovesTable::Table::const_iterator MovesTable::begin() const {
+  return table.cbegin();
+}
+MovesTable::Table::const_iterator MovesTable::end() const {
+  return table.cend();
+}
 MovesTable::Table::const_iterator MovesTable::cbegin() const {
   return table.cbegin();
 }
 MovesTable::Table::const_iterator MovesTable::cend() const {
-  return table.cbegin();
+  return table.cend();
 }
 
 size_t MovesTable::Size() const noexcept { return table.size(); }
@@ -2,8 +2,10 @@
 
 #include "state.h"
 
+#include <cstddef>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
 
 class MovesTable {
 
@@ -11,10 +13,18 @@ protected:
   template <typename Key, typename Tp> using Map = std::unordered_map<Key, Tp>;
   using States = std::unordered_set<State>;
   using Table = Map<State, Map<char, States>>;
+  using Bitmap = std::vector<bool>;
 
   Table table;
 
+  Bitmap initial_states;
+  Bitmap final_states;
+
 public:
+  // NOTE: ids index initial and final bitmaps, so they are bounded to keep
+  // bitmaps small; ids above it are rejected
+  static constexpr State MAX_STATE = (State(1) << 24) - 1;
+
   MovesTable() = default;
   MovesTable(const MovesTable &other) = default;
   MovesTable(MovesTable &&other) = default;
@@ -25,10 +35,19 @@ public:
   States GetNextStates(State current_state, char character) const;
 
   void AddMoveToState(State state, char character, States next_states);
+  void RemoveMoveFromState(State state, char character,
+                           const States &next_states);
   void RemoveState(State state);
 
+  bool IsInitial(State state) const noexcept;
+  bool IsFinal(State state) const noexcept;
+  void SetInitial(State state, bool is_initial = true);
+  void SetFinal(State state, bool is_final = true);
+
   Table::iterator begin();
   Table::iterator end();
+  Table::const_iterator begin() const;
+  Table::const_iterator end() const;
   Table::const_iterator cbegin() const;
   Table::const_iterator cend() const;
 
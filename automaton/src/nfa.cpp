@@ -46,18 +46,19 @@ static std::unordered_set<State> GetStatesList(MovesTable &table) {
 
 static void MergeStates(MovesTable &source_table,
                         const std::unordered_set<State> &source_states) {
-  State new_state{0, false, false};
-  for (auto state : source_states) {
-    if (state.is_final) {
-      new_state.is_final = true;
+  State new_state = 0;
+
+  while (true) {
+    State id = std::rand() % (source_table.Size() * 10);
+    if (!source_table.ContainsState(id)) {
+      new_state = id;
       break;
     }
   }
 
-  while (true) {
-    size_t id = std::rand() % (source_table.Size() * 10);
-    if (!source_table.ContainsState(State{id, false, false})) {
-      new_state.id = id;
+  for (auto state : source_states) {
+    if (source_table.IsFinal(state)) {
+      source_table.SetFinal(new_state);
       break;
     }
   }
@@ -90,9 +91,13 @@ NFA::operator DeterministicFiniteAutomaton() {
 
   const State current_source_state = *current_states.begin();
 
-  std::unordered_map<States, State> mapping;
+  StatesMapping mapping;
   mapping[{current_source_state}] = current_source_state;
 
+  dfa_moves_table.SetInitial(current_source_state);
+  dfa_moves_table.SetFinal(current_source_state,
+                           moves_table.IsFinal(current_source_state));
+
   for (const auto &[character, destination_states] :
        moves_table[current_source_state]) {
     unprocessed_moves.push(
@@ -110,6 +115,13 @@ NFA::operator DeterministicFiniteAutomaton() {
     dfa_moves_table.AddMoveToState(current_source_state, character,
                                    {combined_destination_state});
 
+    for (const State &destination_state : destination_states) {
+      if (moves_table.IsFinal(destination_state)) {
+        dfa_moves_table.SetFinal(combined_destination_state);
+        break;
+      }
+    }
+
     if (current_source_state == combined_destination_state) {
       continue;
     }
@@ -126,13 +138,13 @@ NFA::operator DeterministicFiniteAutomaton() {
             {combined_destination_state, character, next_destination_states});
     }
 
-    std::cout << "\tCurrent source state\t" << current_source_state.id
+    std::cout << "\tCurrent source state\t" << current_source_state
               << std::endl;
     for (auto item : destination_states) {
-      std::cout << item.id << " ";
+      std::cout << item << " ";
     }
     std::cout << std::endl;
-    std::cout << "\tCombined state\t" << combined_destination_state.id
+    std::cout << "\tCombined state\t" << combined_destination_state
               << std::endl;
 
     Out(MovesTable(dfa_moves_table));
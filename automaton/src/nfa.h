@@ -24,4 +24,5 @@ private:
 
   friend class EpsNondeterministicFiniteAutomaton;
   friend class DeterministicFiniteAutomaton;
+  friend class AutomatonBuilder;
 };
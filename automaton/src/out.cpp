@@ -1,9 +1,25 @@
 #include "out.h"
 
+#include <algorithm>
+#include <array>
+#include <cstdio>
 #include <iostream>
+#include <vector>
 
 static const char EPS_CHARACTER = '~';
 
+namespace {
+
+// NOTE: sorted snapshot of table, columns are ordered by character with
+// epsilon moves last, rows by state id
+struct Layout {
+  std::vector<char> columns;
+  std::vector<State> states;
+  std::vector<std::vector<std::vector<State>>> cells;
+};
+
+} // namespace
+
 static size_t CountDigits(size_t number) {
   size_t counter = 1;
 
@@ -14,152 +30,356 @@ static size_t CountDigits(size_t number) {
   return counter;
 }
 
-static void OutHeader(size_t size_of_state,
-                      std::unordered_map<char, size_t> sizes_of_sections) {
-  for (size_t i = 0; i < size_of_state; ++i) {
-    std::cout << ' ';
-  }
+static Layout MakeLayout(const MovesTable &table) {
+  Layout layout;
 
-  for (const auto &[character, size] : sizes_of_sections) {
-    if (character != EPS_CHARACTER) {
-      for (int i = 0; i < size; ++i) {
-        std::cout << ' ';
-      }
-      std::cout << character;
+  for (const auto &[state, dict] : table) {
+    layout.states.push_back(state);
+
+    for (const auto &[character, next_states] : dict) {
+      layout.columns.push_back(character);
     }
   }
 
-  if (sizes_of_sections.contains(EPS_CHARACTER)) {
-    for (int i = 0; i < sizes_of_sections.at(EPS_CHARACTER); ++i) {
-      std::cout << ' ';
+  std::sort(layout.states.begin(), layout.states.end());
+  std::sort(layout.columns.begin(), layout.columns.end(),
+            [](char first, char second) {
+              return (first == EPS_CHARACTER) != (second == EPS_CHARACTER)
+                         ? second == EPS_CHARACTER
+                         : first < second;
+            });
+  layout.columns.erase(
+      std::unique(layout.columns.begin(), layout.columns.end()),
+      layout.columns.end());
+
+  std::array<size_t, 256> column_of{};
+  for (size_t column = 0; column < layout.columns.size(); ++column) {
+    column_of[static_cast<unsigned char>(layout.columns[column])] = column;
+  }
+
+  layout.cells.resize(layout.states.size(),
+                      std::vector<std::vector<State>>(layout.columns.size()));
+
+  for (const auto &[state, dict] : table) {
+    size_t row = std::lower_bound(layout.states.begin(), layout.states.end(),
+                                  state) -
+                 layout.states.begin();
+
+    for (const auto &[character, next_states] : dict) {
+      auto &cell =
+          layout.cells[row][column_of[static_cast<unsigned char>(character)]];
+      cell.assign(next_states.begin(), next_states.end());
+      std::sort(cell.begin(), cell.end());
     }
-    std::cout << "eps";
   }
 
-  std::cout << '\n';
+  return layout;
+}
+
+static void Append(std::string &buffer, State state) {
+  char digits[16];
+  int length = std::snprintf(digits, sizeof(digits), "%u", state);
+  buffer.append(digits, static_cast<size_t>(length));
 }
 
-static void
-OutTableFrameRow(size_t size_of_state,
-                 const std::unordered_map<char, size_t> &sizes_of_sections,
-                 const std::string &opening, const std::string &node,
-                 const std::string &closing) {
-  for (size_t i = 0; i < size_of_state; ++i) {
-    std::cout << ' ';
+static void AppendFrameRow(std::string &buffer, size_t size_of_state,
+                           const std::vector<size_t> &columns_widths,
+                           const char *opening, const char *node,
+                           const char *closing) {
+  buffer.append(size_of_state, ' ');
+  buffer += opening;
+
+  for (size_t width : columns_widths) {
+    for (size_t j = 0; j < width; ++j) {
+      buffer += "─";
+    }
+    buffer += node;
   }
 
-  std::cout << opening;
+  buffer += closing;
+  buffer += '\n';
+}
 
-  for (const auto &[character, size] : sizes_of_sections) {
-    if (character != EPS_CHARACTER) {
-      for (size_t j = 0; j < size; ++j) {
-        std::cout << "─";
-      }
-      std::cout << node;
+static std::string RenderTable(const MovesTable &table, const Layout &layout) {
+  // NOTE: max states counting for wide of output table
+  size_t max_size_of_state = 0;
+  size_t size_of_state_column = 0;
+  std::vector<size_t> columns_widths(layout.columns.size(), 0);
+
+  for (size_t row = 0; row < layout.states.size(); ++row) {
+    State state = layout.states[row];
+    size_t size_of_current_state = CountDigits(state);
+    size_t size_of_flags = table.IsInitial(state) + table.IsFinal(state);
+
+    max_size_of_state = std::max(max_size_of_state, size_of_current_state);
+    size_of_state_column = std::max(size_of_state_column,
+                                    size_of_current_state + size_of_flags);
+
+    for (size_t column = 0; column < layout.columns.size(); ++column) {
+      columns_widths[column] =
+          std::max(columns_widths[column], layout.cells[row][column].size());
     }
   }
 
-  if (sizes_of_sections.contains(EPS_CHARACTER)) {
-    for (size_t j = 0; j < sizes_of_sections.at(EPS_CHARACTER); ++j) {
-      std::cout << "─";
+  for (size_t &width : columns_widths) {
+    width *= (max_size_of_state + 1);
+  }
+
+  size_of_state_column = std::max(size_of_state_column, max_size_of_state + 1);
+
+  std::string buffer;
+  size_t line_size = size_of_state_column + 8;
+  for (size_t width : columns_widths) {
+    line_size += width * 3 + 3;
+  }
+  buffer.reserve(line_size * (2 * layout.states.size() + 4));
+
+  buffer.append(size_of_state_column / 2, ' ');
+  for (size_t column = 0; column < layout.columns.size(); ++column) {
+    buffer.append(columns_widths[column], ' ');
+    if (layout.columns[column] == EPS_CHARACTER) {
+      buffer += "eps";
+    } else {
+      buffer += layout.columns[column];
     }
-    std::cout << node;
   }
+  buffer += '\n';
 
-  std::cout << closing << '\n';
-}
+  AppendFrameRow(buffer, size_of_state_column, columns_widths, "┌", "┬", "┐");
 
-void Out(MovesTable &&table) {
-  // NOTE: max states counting for wide of output table
-  std::unordered_map<char, size_t> columns_widths_dict;
-  size_t max_size_of_state = 0;
+  for (size_t row = 0; row < layout.states.size(); ++row) {
+    State state = layout.states[row];
+    size_t begin = buffer.size();
+
+    if (table.IsInitial(state)) {
+      buffer += '>';
+    }
 
-  for (const auto &[source_state, dict] : table) {
-    size_t size_of_current_state = CountDigits(source_state.id);
-    if (size_of_current_state > max_size_of_state) {
-      max_size_of_state = size_of_current_state;
+    if (table.IsFinal(state)) {
+      buffer += '*';
     }
 
-    for (const auto &[character, destination_states] : dict) {
-      if (destination_states.size() > columns_widths_dict[character]) {
-        columns_widths_dict[character] = destination_states.size();
+    Append(buffer, state);
+    buffer.append(size_of_state_column - (buffer.size() - begin), ' ');
+    buffer += "│";
+
+    for (size_t column = 0; column < layout.columns.size(); ++column) {
+      begin = buffer.size();
+
+      for (State next_state : layout.cells[row][column]) {
+        Append(buffer, next_state);
+        buffer += ' ';
       }
+
+      buffer.append(columns_widths[column] - (buffer.size() - begin), ' ');
+      buffer += "│";
     }
-  }
 
-  for (auto &[character, size] : columns_widths_dict) {
-    size *= (max_size_of_state + 1);
+    buffer += "│\n";
+
+    AppendFrameRow(buffer, size_of_state_column, columns_widths, "├", "┼",
+                   "┤");
   }
 
-  OutHeader((max_size_of_state + 1) / 2, columns_widths_dict);
+  AppendFrameRow(buffer, size_of_state_column, columns_widths, "└", "┴", "┘");
 
-  OutTableFrameRow(max_size_of_state + 1, columns_widths_dict, "┌", "┬", "┐");
+  return buffer;
+}
 
-  for (auto [source_state, dict] : table) {
-    size_t remained = max_size_of_state + 1;
+static std::string ColumnName(char character) {
+  return character == EPS_CHARACTER ? "eps" : std::string(1, character);
+}
+
+static void AppendCsvField(std::string &buffer, const std::string &field) {
+  if (field.find_first_of(",\"\n\r") == std::string::npos) {
+    buffer += field;
+    return;
+  }
 
-    if (source_state.is_initial) {
-      std::cout << '>';
-      --remained;
+  buffer += '"';
+  for (char ch : field) {
+    if (ch == '"') {
+      buffer += '"';
     }
+    buffer += ch;
+  }
+  buffer += '"';
+}
 
-    if (source_state.is_final) {
-      std::cout << '*';
-      --remained;
+static std::string RenderCsv(const MovesTable &table, const Layout &layout) {
+  std::string buffer = "state,initial,final";
+
+  for (char character : layout.columns) {
+    buffer += ',';
+    AppendCsvField(buffer, ColumnName(character));
+  }
+  buffer += '\n';
+
+  for (size_t row = 0; row < layout.states.size(); ++row) {
+    State state = layout.states[row];
+
+    Append(buffer, state);
+    buffer += table.IsInitial(state) ? ",1" : ",0";
+    buffer += table.IsFinal(state) ? ",1" : ",0";
+
+    for (const auto &cell : layout.cells[row]) {
+      buffer += ',';
+      for (size_t i = 0; i < cell.size(); ++i) {
+        if (i) {
+          buffer += ' ';
+        }
+        Append(buffer, cell[i]);
+      }
     }
+    buffer += '\n';
+  }
 
-    std::cout << source_state.id;
+  return buffer;
+}
 
-    remained -= CountDigits(source_state.id);
+static void AppendEscaped(std::string &buffer, char character) {
+  if (character == '"' || character == '\\') {
+    buffer += '\\';
+    buffer += character;
+  } else if (static_cast<unsigned char>(character) < 0x20) {
+    char escaped[8];
+    std::snprintf(escaped, sizeof(escaped), "\\u%04x",
+                  static_cast<unsigned char>(character));
+    buffer += escaped;
+  } else {
+    buffer += character;
+  }
+}
 
-    for (size_t i = 0; i < remained; ++i) {
-      std::cout << ' ';
+static std::string RenderDot(const MovesTable &table, const Layout &layout) {
+  std::string buffer = "digraph automaton {\n"
+                       "  rankdir=LR;\n"
+                       "  node [shape=circle];\n";
+
+  for (State state : layout.states) {
+    buffer += "  ";
+    Append(buffer, state);
+    buffer += table.IsFinal(state) ? " [shape=doublecircle];\n" : ";\n";
+
+    if (table.IsInitial(state)) {
+      buffer += "  start_";
+      Append(buffer, state);
+      buffer += " [shape=point];\n  start_";
+      Append(buffer, state);
+      buffer += " -> ";
+      Append(buffer, state);
+      buffer += ";\n";
     }
+  }
 
-    std::cout << "│";
+  std::vector<std::pair<State, char>> edges;
 
-    for (const auto &[character, size] : columns_widths_dict) {
-      if (character != EPS_CHARACTER) {
-        remained = size;
-        for (auto state : dict[character]) {
-          std::cout << state.id;
+  for (size_t row = 0; row < layout.states.size(); ++row) {
+    edges.clear();
 
-          remained -= CountDigits(state.id);
+    for (size_t column = 0; column < layout.columns.size(); ++column) {
+      for (State next_state : layout.cells[row][column]) {
+        edges.emplace_back(next_state, layout.columns[column]);
+      }
+    }
 
-          std::cout << ' ';
-          --remained;
+    std::stable_sort(
+        edges.begin(), edges.end(),
+        [](const auto &first, const auto &second) {
+          return first.first < second.first;
+        });
+
+    // NOTE: moves between the same pair of states share one edge
+    for (size_t i = 0; i < edges.size();) {
+      buffer += "  ";
+      Append(buffer, layout.states[row]);
+      buffer += " -> ";
+      Append(buffer, edges[i].first);
+      buffer += " [label=\"";
+
+      State next_state = edges[i].first;
+      for (bool first = true; i < edges.size() && edges[i].first == next_state;
+           ++i, first = false) {
+        if (!first) {
+          buffer += ',';
         }
-
-        for (size_t i = 0; i < remained; ++i) {
-          std::cout << ' ';
+        if (edges[i].second == EPS_CHARACTER) {
+          buffer += "eps";
+        } else {
+          AppendEscaped(buffer, edges[i].second);
         }
-
-        std::cout << "│";
       }
+
+      buffer += "\"];\n";
     }
+  }
 
-    if (columns_widths_dict.contains(EPS_CHARACTER)) {
-      remained = columns_widths_dict[EPS_CHARACTER];
-      for (auto state : dict[EPS_CHARACTER]) {
-        std::cout << state.id;
+  buffer += "}\n";
 
-        remained -= CountDigits(state.id);
+  return buffer;
+}
 
-        std::cout << ' ';
-        --remained;
+static std::string RenderJson(const MovesTable &table, const Layout &layout) {
+  std::string buffer = "[";
+
+  for (size_t row = 0; row < layout.states.size(); ++row) {
+    State state = layout.states[row];
+
+    buffer += row ? ",\n  {" : "\n  {";
+    buffer += "\"source_state\": ";
+    Append(buffer, state);
+    buffer += ", \"is_initial_state\": ";
+    buffer += table.IsInitial(state) ? "true" : "false";
+    buffer += ", \"is_final_state\": ";
+    buffer += table.IsFinal(state) ? "true" : "false";
+    buffer += ", \"moves\": [";
+
+    bool first_move = true;
+    for (size_t column = 0; column < layout.columns.size(); ++column) {
+      const auto &cell = layout.cells[row][column];
+      if (cell.empty()) {
+        continue;
       }
 
-      for (size_t i = 0; i < remained; ++i) {
-        std::cout << ' ';
+      buffer += first_move ? "{\"character\": \"" : ", {\"character\": \"";
+      AppendEscaped(buffer, layout.columns[column]);
+      buffer += "\", \"next_states\": [";
+      for (size_t i = 0; i < cell.size(); ++i) {
+        if (i) {
+          buffer += ", ";
+        }
+        Append(buffer, cell[i]);
       }
-
-      std::cout << "│";
+      buffer += "]}";
+      first_move = false;
     }
 
-    std::cout << "│\n";
+    buffer += "]}";
+  }
+
+  buffer += "\n]\n";
 
-    OutTableFrameRow(max_size_of_state + 1, columns_widths_dict, "├", "┼", "┤");
+  return buffer;
+}
+
+std::string Render(const MovesTable &table, OutFormat format) {
+  Layout layout = MakeLayout(table);
+
+  switch (format) {
+  case OutFormat::CSV:
+    return RenderCsv(table, layout);
+  case OutFormat::DOT:
+    return RenderDot(table, layout);
+  case OutFormat::JSON:
+    return RenderJson(table, layout);
+  case OutFormat::TABLE:
+    break;
   }
 
-  OutTableFrameRow(max_size_of_state + 1, columns_widths_dict, "└", "┴", "┘");
+  return RenderTable(table, layout);
+}
+
+void Out(MovesTable &&table, OutFormat format) {
+  std::string rendered = Render(table, format);
+  std::cout.write(rendered.data(), static_cast<std::streamsize>(rendered.size()));
 }
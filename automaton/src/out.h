@@ -2,4 +2,11 @@
 
 #include "movestable.h"
 
-void Out(MovesTable &&table);
+#include <string>
+
+enum class OutFormat { TABLE, CSV, DOT, JSON };
+
+std::string Render(const MovesTable &table,
+                   OutFormat format = OutFormat::TABLE);
+
+void Out(MovesTable &&table, OutFormat format = OutFormat::TABLE);
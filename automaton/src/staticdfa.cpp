@@ -0,0 +1,44 @@
+#include "staticdfa.h"
+
+// NOTE: StaticDFA is header-only and used at compile time, this unit makes
+// the build check its constructions on a few known automata
+
+namespace {
+
+constexpr auto ENDS_WITH_01 = StaticDFA<8>::FromRegex("(0|1)*01");
+static_assert(ENDS_WITH_01.InLanguage("01"));
+static_assert(ENDS_WITH_01.InLanguage("110101"));
+static_assert(!ENDS_WITH_01.InLanguage(""));
+static_assert(!ENDS_WITH_01.InLanguage("010"));
+static_assert(!ENDS_WITH_01.InLanguage("012"));
+
+constexpr auto IDENTIFIER = StaticDFA<8>::FromRegex("[a-z_][a-z0-9_]*");
+static_assert(IDENTIFIER.InLanguage("x"));
+static_assert(IDENTIFIER.InLanguage("a1_b2"));
+static_assert(!IDENTIFIER.InLanguage("1a"));
+static_assert(!IDENTIFIER.InLanguage(""));
+
+constexpr auto NUMBER = StaticDFA<8>::FromRegex("-?[0-9]+(\\.[0-9]+)?");
+static_assert(NUMBER.InLanguage("42"));
+static_assert(NUMBER.InLanguage("-3.14"));
+static_assert(!NUMBER.InLanguage("3."));
+static_assert(!NUMBER.InLanguage("-"));
+
+constexpr auto KEYWORD = StaticDFA<16>::FromRegex("if|then|else(if)?|end");
+static_assert(KEYWORD.InLanguage("else"));
+static_assert(KEYWORD.InLanguage("elseif"));
+static_assert(!KEYWORD.InLanguage("elsei"));
+static_assert(!KEYWORD.InLanguage("iff"));
+
+constexpr auto ANY_BUT_SEPARATOR = StaticDFA<4>::FromRegex("[^;]+;?");
+static_assert(ANY_BUT_SEPARATOR.InLanguage("a = 1;"));
+static_assert(!ANY_BUT_SEPARATOR.InLanguage(";"));
+
+constexpr auto ODD_ONES = StaticDFA<4>::FromMoves(
+    0, {1}, {{0, '0', 0}, {0, '1', 1}, {1, '0', 1}, {1, '1', 0}});
+static_assert(ODD_ONES.Size() == 2);
+static_assert(ODD_ONES.InLanguage("0100"));
+static_assert(!ODD_ONES.InLanguage("0110"));
+static_assert(!ODD_ONES.InLanguage("012"));
+
+} // namespace
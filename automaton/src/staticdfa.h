@@ -0,0 +1,318 @@
+#pragma once
+
+#include "state.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string_view>
+
+// NOTE: header-only DFA for automata known at build time. Both factories are
+// constexpr, so with `constexpr auto dfa = StaticDFA<8>::FromRegex("(0|1)*01")`
+// the whole table is built by the compiler, errors in description become
+// compile errors, and no parsing or allocation happens at startup.
+
+struct StaticMove {
+  State source_state;
+  char character;
+  State next_state;
+};
+
+template <std::size_t MaxStates> class StaticDFA {
+  static_assert(MaxStates > 0 && MaxStates < 0x7fff);
+
+private:
+  using Index = std::int16_t;
+  using Row = std::array<Index, 256>;
+
+  static constexpr Index DEAD = -1;
+
+  std::array<Row, MaxStates> moves{};
+  std::array<bool, MaxStates> final_states{};
+  std::size_t size = 0;
+
+public:
+  constexpr bool InLanguage(std::string_view word) const noexcept {
+    Index state = 0;
+
+    for (char ch : word) {
+      state = moves[state][static_cast<unsigned char>(ch)];
+      if (state == DEAD) {
+        return false;
+      }
+    }
+
+    return final_states[state];
+  }
+
+  constexpr std::size_t Size() const noexcept { return size; }
+
+  static constexpr StaticDFA
+  FromMoves(State initial_state, std::initializer_list<State> final_states,
+            std::initializer_list<StaticMove> moves) {
+    StaticDFA dfa = Empty();
+    std::array<State, MaxStates> ids{};
+
+    auto index_of = [&](State id) -> Index {
+      for (std::size_t i = 0; i < dfa.size; ++i) {
+        if (ids[i] == id) {
+          return static_cast<Index>(i);
+        }
+      }
+      if (dfa.size == MaxStates) {
+        throw "Exception: StaticDFA capacity exceeded";
+      }
+      ids[dfa.size] = id;
+      return static_cast<Index>(dfa.size++);
+    };
+
+    index_of(initial_state);
+
+    for (const StaticMove &move : moves) {
+      Index source = index_of(move.source_state);
+      Index next = index_of(move.next_state);
+      Index &cell =
+          dfa.moves[source][static_cast<unsigned char>(move.character)];
+
+      if (cell != DEAD && cell != next) {
+        throw "Exception: Invalid DFA";
+      }
+      cell = next;
+    }
+
+    for (State id : final_states) {
+      dfa.final_states[index_of(id)] = true;
+    }
+
+    return dfa;
+  }
+
+  // NOTE: supports literals, '\' escapes, '.', classes like [a-z0-9] and
+  // [^;], grouping, '|', '*', '+' and '?'. Built by Glushkov construction
+  // (one position per literal, at most 63) followed by subset construction.
+  static constexpr StaticDFA FromRegex(std::string_view pattern) {
+    RegexParser parser{pattern};
+    Fragment fragment = parser.Alternation();
+
+    if (parser.position != pattern.size()) {
+      throw "Exception: Invalid regex";
+    }
+
+    parser.follow[START] = fragment.first;
+    Mask last = fragment.last | (fragment.nullable ? Bit(START) : 0);
+
+    StaticDFA dfa = Empty();
+    std::array<Mask, MaxStates> sets{};
+
+    sets[0] = Bit(START);
+    dfa.size = 1;
+
+    for (std::size_t i = 0; i < dfa.size; ++i) {
+      Mask candidates = 0;
+      for (std::size_t p = 0; p < 64; ++p) {
+        if (sets[i] & Bit(p)) {
+          candidates |= parser.follow[p];
+        }
+      }
+
+      dfa.final_states[i] = (sets[i] & last) != 0;
+
+      for (std::size_t ch = 0; ch < 256; ++ch) {
+        Mask next = 0;
+        for (std::size_t p = 0; p < parser.count; ++p) {
+          if ((candidates & Bit(p)) && parser.characters[p].Contains(ch)) {
+            next |= Bit(p);
+          }
+        }
+
+        if (!next) {
+          continue;
+        }
+
+        std::size_t j = 0;
+        while (j < dfa.size && sets[j] != next) {
+          ++j;
+        }
+
+        if (j == dfa.size) {
+          if (dfa.size == MaxStates) {
+            throw "Exception: StaticDFA capacity exceeded";
+          }
+          sets[dfa.size++] = next;
+        }
+
+        dfa.moves[i][ch] = static_cast<Index>(j);
+      }
+    }
+
+    return dfa;
+  }
+
+private:
+  using Mask = std::uint64_t;
+
+  static constexpr std::size_t START = 63;
+
+  static constexpr Mask Bit(std::size_t position) {
+    return Mask{1} << position;
+  }
+
+  static constexpr StaticDFA Empty() {
+    StaticDFA dfa;
+    for (Row &row : dfa.moves) {
+      row.fill(DEAD);
+    }
+    return dfa;
+  }
+
+  struct CharacterSet {
+    std::array<Mask, 4> bits{};
+
+    constexpr void Add(std::size_t ch) { bits[ch / 64] |= Bit(ch % 64); }
+    constexpr bool Contains(std::size_t ch) const {
+      return (bits[ch / 64] & Bit(ch % 64)) != 0;
+    }
+    constexpr void Invert() {
+      for (Mask &part : bits) {
+        part = ~part;
+      }
+    }
+  };
+
+  struct Fragment {
+    bool nullable = true;
+    Mask first = 0;
+    Mask last = 0;
+  };
+
+  struct RegexParser {
+    std::string_view pattern;
+    std::size_t position = 0;
+    std::size_t count = 0;
+    std::array<CharacterSet, 64> characters{};
+    std::array<Mask, 64> follow{};
+
+    constexpr bool AtEnd() const { return position == pattern.size(); }
+    constexpr char Peek() const { return pattern[position]; }
+
+    constexpr unsigned char Take() {
+      if (AtEnd()) {
+        throw "Exception: Invalid regex";
+      }
+      return static_cast<unsigned char>(pattern[position++]);
+    }
+
+    constexpr void Link(Mask from, Mask to) {
+      for (std::size_t p = 0; p < 64; ++p) {
+        if (from & Bit(p)) {
+          follow[p] |= to;
+        }
+      }
+    }
+
+    constexpr Fragment Alternation() {
+      Fragment result = Concatenation();
+
+      while (!AtEnd() && Peek() == '|') {
+        ++position;
+        Fragment other = Concatenation();
+        result.nullable = result.nullable || other.nullable;
+        result.first |= other.first;
+        result.last |= other.last;
+      }
+
+      return result;
+    }
+
+    constexpr Fragment Concatenation() {
+      Fragment result;
+
+      while (!AtEnd() && Peek() != '|' && Peek() != ')') {
+        Fragment next = Repetition();
+        Link(result.last, next.first);
+        result.first |= result.nullable ? next.first : 0;
+        result.last = next.last | (next.nullable ? result.last : 0);
+        result.nullable = result.nullable && next.nullable;
+      }
+
+      return result;
+    }
+
+    constexpr Fragment Repetition() {
+      Fragment result = Atom();
+
+      while (!AtEnd() && (Peek() == '*' || Peek() == '+' || Peek() == '?')) {
+        char op = pattern[position++];
+        if (op != '?') {
+          Link(result.last, result.first);
+        }
+        if (op != '+') {
+          result.nullable = true;
+        }
+      }
+
+      return result;
+    }
+
+    constexpr Fragment Atom() {
+      unsigned char ch = Take();
+
+      if (ch == '(') {
+        Fragment result = Alternation();
+        if (Take() != ')') {
+          throw "Exception: Invalid regex";
+        }
+        return result;
+      }
+
+      CharacterSet set;
+
+      if (ch == '.') {
+        set.Invert();
+      } else if (ch == '[') {
+        bool negated = !AtEnd() && Peek() == '^';
+        position += negated ? 1 : 0;
+
+        while (!AtEnd() && Peek() != ']') {
+          unsigned char from = Take();
+          from = from == '\\' ? Take() : from;
+          unsigned char to = from;
+
+          if (position + 1 < pattern.size() && Peek() == '-' &&
+              pattern[position + 1] != ']') {
+            ++position;
+            to = Take();
+            to = to == '\\' ? Take() : to;
+          }
+
+          for (std::size_t c = from; c <= to; ++c) {
+            set.Add(c);
+          }
+        }
+
+        if (Take() != ']') {
+          throw "Exception: Invalid regex";
+        }
+        if (negated) {
+          set.Invert();
+        }
+      } else if (ch == ')' || ch == '*' || ch == '+' || ch == '?' ||
+                 ch == ']') {
+        throw "Exception: Invalid regex";
+      } else {
+        set.Add(ch == '\\' ? Take() : ch);
+      }
+
+      if (count == START) {
+        throw "Exception: Regex is too long";
+      }
+
+      characters[count] = set;
+      Fragment result{false, Bit(count), Bit(count)};
+      ++count;
+
+      return result;
+    }
+  };
+};
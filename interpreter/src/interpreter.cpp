@@ -1,8 +1,14 @@
 #include "interpreter.h"
-#include <iostream>
+
+Interpreter::Interpreter(std::istream &input, std::ostream &output)
+    : input(input), output(output) {}
 
 void Interpreter::Debug(Entry entry) {
-  std::cerr << "Current entry: ";
+  if (!trace) {
+    return;
+  }
+
+  *trace << "Current entry: ";
   if (entry.type == Entry::EntryType::COMMAND) {
     auto command = std::get<Entry::Command>(entry.data);
     std::string cmd;
@@ -53,65 +59,69 @@ void Interpreter::Debug(Entry entry) {
       cmd = "JMP";
       break;
     }
-    std::cerr << cmd;
+    *trace << cmd;
   } else if (entry.type == Entry::EntryType::CONSTANT ||
              entry.type == Entry::EntryType::INSTRUCTION_POINTER) {
-    std::cerr << std::get<int>(entry.data);
+    *trace << std::get<int>(entry.data);
   } else if (entry.type == Entry::EntryType::VARIABLE) {
-    std::cerr << std::get<std::string>(entry.data);
+    *trace << parser.symbols.Name(std::get<Symbol>(entry.data));
   }
-  std::cerr << std::endl;
+  *trace << std::endl;
 
   auto stackCopy = stack;
-  std::cerr << "Stack (HEAD->TAIL): ";
+  *trace << "Stack (HEAD->TAIL): ";
   while (!stackCopy.empty()) {
-    try {
-      std::cerr << std::get<std::string>(stackCopy.top()) << " ";
-    } catch (...) {
-      std::cerr << std::get<int>(stackCopy.top()) << " ";
+    if (std::holds_alternative<Symbol>(stackCopy.top())) {
+      *trace << parser.symbols.Name(std::get<Symbol>(stackCopy.top()))
+                << " ";
+    } else {
+      *trace << std::get<int>(stackCopy.top()) << " ";
     }
     stackCopy.pop();
   }
-  std::cerr << std::endl;
+  *trace << std::endl;
 
-  for (const auto &[var, value] : variables) {
-    std::cerr << var << "=" << value << "; ";
+  for (size_t var = 0; var < variables.size(); ++var) {
+    if (initialized[var]) {
+      *trace << parser.symbols.Name(static_cast<Symbol>(var)) << "="
+                << variables[var] << "; ";
+    }
   }
-  std::cerr << std::endl;
+  *trace << std::endl;
 }
 
-int Interpreter::Value(const std::variant<int, std::string> &operand) {
-  int value;
-  try {
-    value = std::get<int>(stack.top());
-  } catch (...) {
-    auto var = std::get<std::string>(stack.top());
-    if (!variables.contains(var)) {
-      variables[var] = 0;
-    }
-    value = variables[var];
+int Interpreter::Value(const std::variant<int, Symbol> &operand) {
+  if (std::holds_alternative<int>(operand)) {
+    return std::get<int>(operand);
   }
-  return value;
+
+  size_t var = static_cast<size_t>(std::get<Symbol>(operand));
+  initialized[var] = true;
+  return variables[var];
 }
 
 void Interpreter::InitializeVariables(const std::vector<Entry> &pir) {
+  variables.assign(parser.symbols.Size(), 0);
+  initialized.assign(parser.symbols.Size(), false);
+
   for (auto &entry : pir) {
     if (entry.type == Entry::EntryType::VARIABLE) {
-      const auto &varName = std::get<std::string>(entry.data);
-      if (!variables.contains(varName)) {
-        std::cout << varName << "=";
-        std::cin >> variables[varName];
+      size_t var = static_cast<size_t>(std::get<Symbol>(entry.data));
+      if (!initialized[var]) {
+        output << parser.symbols.Name(std::get<Symbol>(entry.data)) << "=";
+        input >> variables[var];
+        initialized[var] = true;
       }
     }
   }
 }
 
 bool Interpreter::Interprete(const std::string &text) {
-  const auto &[record, success] = parser.Parse(text);
-  if (!success) {
+  if (!parser.Parse(text, entries, diagnostics)) {
     return false;
   }
-  auto entries = std::move(record);
+
+  stack = {};
 
   InitializeVariables(entries);
 
@@ -122,19 +132,19 @@ bool Interpreter::Interprete(const std::string &text) {
       int value = std::get<int>(iter->data);
       stack.push(value);
     } else if (iter->type == Entry::EntryType::VARIABLE) {
-      auto var = std::get<std::string>(iter->data);
-      stack.push(var);
+      stack.push(std::get<Symbol>(iter->data));
     } else if (iter->type == Entry::EntryType::COMMAND) {
       auto cmd = std::get<Entry::Command>(iter->data);
       switch (cmd) {
       case Entry::Command::INPUT: {
-        auto op = std::move(std::get<std::string>(stack.top()));
+        size_t op = static_cast<size_t>(std::get<Symbol>(stack.top()));
         stack.pop();
-        std::cin >> variables[op];
+        input >> variables[op];
+        initialized[op] = true;
         break;
       }
       case Entry::Command::OUTPUT:
-        std::cout << Value(stack.top());
+        output << Value(stack.top());
         stack.pop();
         break;
       case Entry::Command::CMPE: {
@@ -172,9 +182,10 @@ bool Interpreter::Interprete(const std::string &text) {
       case Entry::Command::MOV: {
         int op2 = Value(stack.top());
         stack.pop();
-        auto op1 = std::move(std::get<std::string>(stack.top()));
+        size_t op1 = static_cast<size_t>(std::get<Symbol>(stack.top()));
         stack.pop();
         variables[op1] = op2;
+        initialized[op1] = true;
         break;
       }
       case Entry::Command::OR: {
@@ -1,20 +1,37 @@
 #pragma once
 
 #include "../../semantic_analyzer/src/parser.h"
-#include <optional>
+#include <iostream>
 #include <stack>
 
+// NOTE: whole pipeline from text to execution. Instance keeps no state of
+// previous program, and instances share nothing, so they may be used from
+// different threads
 class Interpreter {
 public:
+  explicit Interpreter(std::istream &input = std::cin,
+                       std::ostream &output = std::cout);
+
+  // NOTE: program is run only if it has no diagnostics
   bool Interprete(const std::string &text);
 
 private:
-  int Value(const std::variant<int, std::string> &operand);
+  int Value(const std::variant<int, Symbol> &operand);
   void Debug(Entry entry);
   void InitializeVariables(const std::vector<Entry> &pir);
 
 public:
   SyntacticParser parser;
-  std::stack<std::variant<int, std::string>> stack;
-  std::unordered_map<std::string, int> variables;
+  std::vector<Entry> entries;
+  std::vector<Diagnostic> diagnostics;
+  // NOTE: when set, every executed entry is traced into it
+  std::ostream *trace = nullptr;
+  std::stack<std::variant<int, Symbol>> stack;
+  // NOTE: indexed by symbols of parser
+  std::vector<int> variables;
+  std::vector<bool> initialized;
+
+private:
+  std::istream &input;
+  std::ostream &output;
 };
@@ -3,5 +3,13 @@
 
 int main(int argc, char **argv) {
   Interpreter interpreter;
-  std::cout << (interpreter.Interprete(argv[1]) ? "\nOK\n" : "\nNOT OK\n");
+  interpreter.trace = &std::cerr;
+
+  bool success = interpreter.Interprete(argv[1]);
+
+  for (const Diagnostic &diagnostic : interpreter.diagnostics) {
+    std::cerr << diagnostic.line << ":" << diagnostic.column << ": "
+              << diagnostic.message << std::endl;
+  }
+  std::cout << (success ? "\nOK\n" : "\nNOT OK\n");
 }
@@ -0,0 +1,182 @@
+#include "../src/analyzer.h"
+#include "../src/parallel.h"
+#include "../src/stream.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+
+static const size_t MIN_SIZE = 64 << 10;
+static const size_t MAX_SIZE = 16 << 20;
+static const size_t CORPUS_SIZE = 1 << 20;
+static const int RUNS = 5;
+
+// NOTE: generated program is lexically (not syntactically) valid: indented
+// assignments with long identifiers, constants and all kinds of operators
+static std::string Generate(size_t size) {
+  static const char *const OPERATORS[] = {"+", "-", "*", "/", "<", ">",
+                                          "==", "<>"};
+  static const char *const KEYWORDS[] = {"if", "then", "elseif", "else",
+                                         "end", "and", "or", "input",
+                                         "output"};
+
+  std::mt19937 random(42);
+  std::string text;
+  text.reserve(size + 256);
+
+  auto identifier = [&] {
+    std::string name = "variable_";
+    name.back() = 'a' + random() % 26;
+    for (size_t length = 4 + random() % 24; name.size() < length;) {
+      name += random() % 4 ? char('a' + random() % 26)
+                           : char('0' + random() % 10);
+    }
+    return name;
+  };
+
+  while (text.size() < size) {
+    text.append(4 * (1 + random() % 4), ' ');
+
+    if (random() % 8 == 0) {
+      text += KEYWORDS[random() % std::size(KEYWORDS)];
+      text += ' ';
+    }
+
+    text += identifier();
+    text += " = ";
+    for (int operand = 0, count = 1 + random() % 5; operand < count;
+         ++operand) {
+      if (operand) {
+        text += ' ';
+        text += OPERATORS[random() % std::size(OPERATORS)];
+        text += ' ';
+      }
+      if (random() % 3 == 0) {
+        text += std::to_string(random());
+      } else if (random() % 5 == 0) {
+        text += "(" + identifier() + ")";
+      } else {
+        text += identifier();
+      }
+    }
+    text += ";\n";
+  }
+
+  return text;
+}
+
+static void Measure(const std::string &name, std::string_view text,
+                    const std::function<size_t()> &run) {
+  double best = 0;
+  size_t tokens = 0;
+
+  for (int i = 0; i < RUNS; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    tokens = run();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (i == 0 || elapsed.count() < best) {
+      best = elapsed.count();
+    }
+  }
+
+  std::cout << std::left << std::setw(20) << name << std::right
+            << std::setw(12) << tokens << " tokens" << std::fixed
+            << std::setprecision(1) << std::setw(10) << tokens / best / 1e6
+            << " Mtokens/s" << std::setw(10) << text.size() / best / 1e6
+            << " MB/s\n";
+}
+
+static std::string Read(const std::filesystem::path &path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    std::cerr << "can't open '" << path.string() << "'" << std::endl;
+    exit(1);
+  }
+  std::stringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+static void MeasureAll(const std::string &text) {
+  std::cout << "input: " << text.size() << " bytes, best of " << RUNS
+            << " runs\n";
+
+  try {
+    Measure("Analyse", text,
+            [&] { return LexicalAnalyzer().Analyse(text).size(); });
+    Measure("Tokenize", text,
+            [&] { return LexicalAnalyzer().Tokenize(text).Size(); });
+    Measure("AnalyseParallel", text,
+            [&] { return AnalyseParallel(text).size(); });
+    Measure("LexemeStream", text, [&] {
+      LexemeStream stream(text);
+      size_t count = 0;
+      while (stream.NextToken()) {
+        ++count;
+      }
+      return count;
+    });
+  } catch (std::string exception) {
+    std::cerr << exception << std::endl;
+    exit(1);
+  }
+}
+
+// NOTE: fuzz inputs are tiny and stress edge cases such as '='/'<'
+// lookahead, long runs and errors, so each one is repeated line by line up
+// to CORPUS_SIZE and lexed by recovering Tokenize, which accepts them all
+static void MeasureCorpus(const std::filesystem::path &directory) {
+  std::vector<std::filesystem::path> paths;
+  for (const auto &entry :
+       std::filesystem::recursive_directory_iterator(directory)) {
+    if (entry.is_regular_file()) {
+      paths.push_back(entry.path());
+    }
+  }
+  std::sort(paths.begin(), paths.end());
+
+  std::cout << "corpus: " << paths.size() << " inputs repeated up to "
+            << CORPUS_SIZE << " bytes, best of " << RUNS << " runs\n";
+
+  LexicalAnalyzer analyzer;
+  TokenBuffer tokens;
+  std::vector<Diagnostic> diagnostics;
+
+  for (const auto &path : paths) {
+    const std::string input = Read(path);
+    std::string text;
+    while (!input.empty() && text.size() < CORPUS_SIZE) {
+      text += input;
+      text += '\n';
+    }
+
+    // NOTE: Tokenize appends diagnostics, so they are cleared every run
+    Measure(path.filename().string(), text, [&] {
+      diagnostics.clear();
+      analyzer.Tokenize(text, tokens, diagnostics);
+      return tokens.Size();
+    });
+  }
+}
+
+// NOTE: usage: lexer_bench [file | --corpus <directory>]; without arguments
+// lexes generated programs from 64 KB to 16 MB, growing by 4 times
+int main(int argc, char **argv) {
+  if (argc > 2 && std::string(argv[1]) == "--corpus") {
+    MeasureCorpus(argv[2]);
+  } else if (argc > 1) {
+    MeasureAll(Read(argv[1]));
+  } else {
+    for (size_t size = MIN_SIZE; size <= MAX_SIZE; size *= 4) {
+      MeasureAll(Generate(size));
+    }
+  }
+}
@@ -0,0 +1,132 @@
+#include "../src/analyzer.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+// NOTE: checks that all lexer entry points agree on the same input. Built
+// with libFuzzer when LEXER_LIBFUZZER is on, otherwise main below replays
+// corpus files and directories given as arguments
+
+static void Check(bool condition, const char *what) {
+  if (!condition) {
+    std::fprintf(stderr, "lexer fuzz: %s\n", what);
+    std::abort();
+  }
+}
+
+static bool Same(const Lexeme &first, const Lexeme &second) {
+  return first.type == second.type && first.category == second.category &&
+         first.value == second.value && first.line == second.line &&
+         first.column == second.column;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t *data,
+                                      std::size_t size) {
+  const std::string_view text(reinterpret_cast<const char *>(data), size);
+  LexicalAnalyzer analyzer;
+
+  std::vector<Lexeme> lexemes;
+  bool failed = false;
+  try {
+    lexemes = analyzer.Analyse(text);
+  } catch (std::string) {
+    failed = true;
+  }
+
+  AnalysisResult result = analyzer.AnalyseRecovering(text);
+  Check(failed == !result.diagnostics.empty(),
+        "recovering analysis disagrees on errors");
+
+  size_t errors = 0;
+  size_t covered = 0;
+  for (const Lexeme &lexeme : result.lexemes) {
+    errors += lexeme.type == Lexeme::Type::ERROR;
+    Check(!lexeme.value.empty(), "empty lexeme");
+    Check(lexeme.value.data() >= text.data() + covered,
+          "lexemes overlap or go backwards");
+    covered = lexeme.value.data() + lexeme.value.size() - text.data();
+  }
+  Check(errors == result.diagnostics.size(), "ERROR lexemes without report");
+
+  if (failed) {
+    return 0;
+  }
+
+  Check(result.lexemes.size() == lexemes.size(),
+        "recovering analysis lost lexemes");
+
+  TokenBuffer tokens = analyzer.Tokenize(text);
+  Check(tokens.Size() == lexemes.size(), "token buffer size");
+  for (size_t i = 0; i < lexemes.size(); ++i) {
+    Check(Same(result.lexemes[i], lexemes[i]), "recovering analysis lexeme");
+    Check(tokens.Type(i) == lexemes[i].type &&
+              tokens.Category(i) == lexemes[i].category &&
+              tokens.Value(i) == lexemes[i].value,
+          "token buffer lexeme");
+  }
+
+  // NOTE: text is revealed by growing prefixes as if it was read by chunks
+  // of 1..7 symbols, lexemes split between chunks must come out whole
+  const size_t chunk = size % 7 + 1;
+  LexicalAnalyzer::Cursor cursor;
+  Lexeme lexeme{};
+  size_t visible = std::min(chunk, size);
+  size_t index = 0;
+
+  while (true) {
+    const bool is_last = visible == size;
+    if (analyzer.Next(text.substr(0, visible), is_last, cursor, lexeme)) {
+      Check(index < lexemes.size() && Same(lexeme, lexemes[index]),
+            "chunked analysis lexeme");
+      ++index;
+    } else if (is_last) {
+      break;
+    } else {
+      visible = std::min(visible + chunk, size);
+    }
+  }
+  Check(index == lexemes.size(), "chunked analysis lost lexemes");
+
+  return 0;
+}
+
+#if !defined(LEXER_LIBFUZZER)
+
+static void Replay(const std::filesystem::path &path, size_t &count) {
+  std::ifstream file(path, std::ios::binary);
+  std::stringstream content;
+  content << file.rdbuf();
+  const std::string input = content.str();
+
+  LLVMFuzzerTestOneInput(reinterpret_cast<const std::uint8_t *>(input.data()),
+                         input.size());
+  ++count;
+}
+
+int main(int argc, char **argv) {
+  size_t count = 0;
+
+  for (int i = 1; i < argc; ++i) {
+    if (std::filesystem::is_directory(argv[i])) {
+      for (const auto &entry :
+           std::filesystem::recursive_directory_iterator(argv[i])) {
+        if (entry.is_regular_file()) {
+          Replay(entry.path(), count);
+        }
+      }
+    } else {
+      Replay(argv[i], count);
+    }
+  }
+
+  std::cout << count << " inputs passed\n";
+}
+
+#endif
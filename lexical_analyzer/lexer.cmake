@@ -0,0 +1,35 @@
+# NOTE: builds lexer once as library lexer_core for every project including
+# this module. LEXER_SRC lists its sources for targets which have to compile
+# them with their own flags, such as sanitized fuzz harness
+
+set(LEXER_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+set(LEXER_SRC
+  ${LEXER_DIR}/src/analyzer.cpp
+  ${LEXER_DIR}/src/scan.cpp
+  ${LEXER_DIR}/src/stream.cpp
+  ${LEXER_DIR}/src/parallel.cpp
+)
+
+set(LEXER_HEADER
+  ${LEXER_DIR}/src/state.h
+
+  ${LEXER_DIR}/src/lexeme.h
+  ${LEXER_DIR}/src/analyzer.h
+  ${LEXER_DIR}/src/tokens.h
+  ${LEXER_DIR}/src/scan.h
+  ${LEXER_DIR}/src/stream.h
+  ${LEXER_DIR}/src/parallel.h
+)
+
+find_package(Threads REQUIRED)
+
+if(NOT TARGET lexer_core)
+  add_library(lexer_core ${LEXER_SRC} ${LEXER_HEADER})
+
+  target_compile_options(lexer_core PUBLIC -std=c++20)
+  # NOTE: benchmarks link the same library, so it is optimized unless
+  # Debug build is asked for
+  target_compile_options(lexer_core PRIVATE $<$<NOT:$<CONFIG:Debug>>:-O2>)
+  target_link_libraries(lexer_core PUBLIC Threads::Threads)
+endif()
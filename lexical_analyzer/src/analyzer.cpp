@@ -1,223 +1,396 @@
 #include "analyzer.h"
 #include "lexeme.h"
+#include "scan.h"
 
-#include <cctype>
-#include <iostream>
-#include <sstream>
-#include <unordered_set>
+#include <algorithm>
+#include <array>
 
 LexicalAnalyzer::LexicalAnalyzer() : _state(State::START) {}
 
-std::vector<Lexeme> LexicalAnalyzer::Analyse(const std::string &text) {
-  std::vector<Lexeme> lexemes;
-
-  const std::unordered_set<char> EXACTLY_SINGLE_SYMBOL_OPERATOR{
-      '>', '+', '-', '*', '/', '(', ')', ';'};
+// NOTE: line and column are counted on demand, since errors are rare
+Diagnostic Locate(std::string_view text, std::size_t offset) {
+  std::string_view prefix = text.substr(0, offset);
+  std::size_t line_begin = prefix.rfind('\n') + 1;
 
-  size_t row_number = 1;
-  size_t col_number = 1;
+  Diagnostic diagnostic;
+  diagnostic.line = static_cast<std::uint32_t>(
+      std::count(prefix.begin(), prefix.end(), '\n') + 1);
+  diagnostic.column = static_cast<std::uint32_t>(offset - line_begin + 1);
+  return diagnostic;
+}
 
-  std::string error_message;
-  std::stringstream lexeme;
-  for (char ch : text) {
-    if (ch == '\n') {
-      ++row_number;
-      col_number = 1;
+static Lexeme Word(Lexeme::Category category, std::string_view value,
+                   std::uint32_t line, std::uint32_t column) {
+  if (category == Lexeme::Category::IDENTIFIER) {
+    if (Lexeme::Type type = KeywordType(value);
+        type != Lexeme::Type::UNDEFINED) {
+      return {type, Lexeme::Category::KEYWORD, value, line, column};
     }
+  }
 
-    switch (_state) {
+  return {Lexeme::Type::UNDEFINED, category, value, line, column};
+}
 
-    case State::START:
-      lexeme.str("");
+static Lexeme Terminal(std::string_view value, std::uint32_t line,
+                       std::uint32_t column) {
+  Lexeme::Type type = Lexeme::Type::UNDEFINED;
+
+  switch (value.front()) {
+  case '<':
+  case '>':
+  case '=':
+    type = value == "=" ? Lexeme::Type::ASSIGNMENT : Lexeme::Type::RELATION;
+    break;
+  case '+':
+  case '-':
+    type = Lexeme::Type::ARITHMETIC_SIMPLE;
+    break;
+  case '*':
+  case '/':
+    type = Lexeme::Type::ARITHMETIC_DIFICULT;
+    break;
+  case '(':
+  case ')':
+    type = Lexeme::Type::BRACKET;
+    break;
+  case ';':
+    type = Lexeme::Type::SEPARATOR;
+    break;
+  }
 
-      if (std::isdigit(ch)) {
-        _state = State::READING_CONSTANT;
+  return {type, Lexeme::Category::SPECIAL_SYMBOL, value, line, column};
+}
 
-        lexeme << ch;
-      } else if (std::isalpha(ch)) {
-        _state = State::READING_IDENTIFIER;
+namespace {
+
+enum CharClass : std::uint8_t {
+  DIGIT,
+  LETTER,
+  SPACE,
+  EQUAL,
+  LESS,
+  GREATER,
+  OPENING_BRACKET,
+  OPERATOR,
+  OTHER,
+  CHAR_CLASSES_COUNT
+};
+
+// NOTE: every action ends lexeme and returns it, so moves with action lead to
+// START and carry one action only. FLUSH_IDENTIFIER, FLUSH_CONSTANT and
+// FLUSH_OPERATOR end it before the current symbol, which is scanned again
+// from START by the next call, the other two end it with the current symbol
+enum Action : std::uint8_t {
+  NONE = 0,
+  FLUSH_IDENTIFIER = 1 << 0,
+  FLUSH_CONSTANT = 1 << 1,
+  FLUSH_OPERATOR = 1 << 2,
+  FLUSH_OPERATOR_WITH_CURRENT = 1 << 3,
+  SINGLE = 1 << 4,
+};
+
+struct Move {
+  State next = State::ERROR;
+  std::uint8_t actions = NONE;
+};
+
+constexpr std::size_t STATES_COUNT =
+    State::READING_OPERATOR_LESS_OR_NOT_EQUAL + 1;
+
+using MovesTable =
+    std::array<std::array<Move, CHAR_CLASSES_COUNT>, STATES_COUNT>;
+
+constexpr std::array<CharClass, 256> MakeCharClasses() {
+  std::array<CharClass, 256> classes{};
+  classes.fill(OTHER);
+
+  for (int ch = '0'; ch <= '9'; ++ch) {
+    classes[ch] = DIGIT;
+  }
+  for (int ch = 'a'; ch <= 'z'; ++ch) {
+    classes[ch] = LETTER;
+    classes[ch - 'a' + 'A'] = LETTER;
+  }
+  for (unsigned char ch : {' ', '\t', '\n', '\v', '\f', '\r'}) {
+    classes[ch] = SPACE;
+  }
+  for (unsigned char ch : {'+', '-', '*', '/', ')', ';'}) {
+    classes[ch] = OPERATOR;
+  }
+  classes['='] = EQUAL;
+  classes['<'] = LESS;
+  classes['>'] = GREATER;
+  classes['('] = OPENING_BRACKET;
 
-        lexeme << ch;
-      } else if (EXACTLY_SINGLE_SYMBOL_OPERATOR.contains(ch)) {
-        _state = State::START;
+  return classes;
+}
 
-        lexemes.push_back(TERMINAL_LEXEMES.at(std::string(1, ch)));
-      } else if (ch == '=') {
-        _state = State::READING_OPERATOR_ASSIGNMENT_OR_EQUAL;
-      } else if (ch == '<') {
-        _state = State::READING_OPERATOR_LESS_OR_NOT_EQUAL;
-      } else if (std::isspace(ch)) {
-      } else {
-        _state = State::ERROR;
+constexpr MovesTable MakeMovesTable() {
+  MovesTable moves;
+  for (auto &row : moves) {
+    row.fill(Move{State::ERROR, NONE});
+  }
 
-        error_message = "undefined symbol";
-      }
-      break;
-
-    case State::READING_IDENTIFIER:
-      if (std::isalnum(ch)) {
-        lexeme << ch;
-      } else if (std::isspace(ch)) {
-        _state = State::START;
-
-        std::string ready_made_lexeme = lexeme.str();
-        lexemes.push_back(TERMINAL_LEXEMES.contains(ready_made_lexeme)
-                              ? TERMINAL_LEXEMES.at(ready_made_lexeme)
-                              : Lexeme{Lexeme::Type::UNDEFINED,
-                                       Lexeme::Category::IDENTIFIER,
-                                       lexeme.str()});
-      } else if (EXACTLY_SINGLE_SYMBOL_OPERATOR.contains(ch)) {
-        _state = State::START;
-
-        std::string ready_made_lexeme = lexeme.str();
-        lexemes.push_back(TERMINAL_LEXEMES.contains(ready_made_lexeme)
-                              ? TERMINAL_LEXEMES.at(ready_made_lexeme)
-                              : Lexeme{Lexeme::Type::UNDEFINED,
-                                       Lexeme::Category::IDENTIFIER,
-                                       lexeme.str()});
-        lexemes.push_back(TERMINAL_LEXEMES.at(std::string(1, ch)));
-      } else if (ch == '=') {
-        _state = State::READING_OPERATOR_ASSIGNMENT_OR_EQUAL;
-
-        std::string ready_made_lexeme = lexeme.str();
-        lexemes.push_back(TERMINAL_LEXEMES.contains(ready_made_lexeme)
-                              ? TERMINAL_LEXEMES.at(ready_made_lexeme)
-                              : Lexeme{Lexeme::Type::UNDEFINED,
-                                       Lexeme::Category::IDENTIFIER,
-                                       lexeme.str()});
-      } else if (ch == '<') {
-        _state = State::READING_OPERATOR_LESS_OR_NOT_EQUAL;
-
-        std::string ready_made_lexeme = lexeme.str();
-        lexemes.push_back(TERMINAL_LEXEMES.contains(ready_made_lexeme)
-                              ? TERMINAL_LEXEMES.at(ready_made_lexeme)
-                              : Lexeme{Lexeme::Type::UNDEFINED,
-                                       Lexeme::Category::IDENTIFIER,
-                                       lexeme.str()});
-      } else {
-        _state = State::ERROR;
-
-        error_message = "incorrect identifier symbol";
-      }
-      break;
+  // NOTE: start of lexeme and exactly single symbol operators
+  auto &start = moves[State::START];
+  start[DIGIT] = {State::READING_CONSTANT, NONE};
+  start[LETTER] = {State::READING_IDENTIFIER, NONE};
+  start[SPACE] = {State::START, NONE};
+  start[EQUAL] = {State::READING_OPERATOR_ASSIGNMENT_OR_EQUAL, NONE};
+  start[LESS] = {State::READING_OPERATOR_LESS_OR_NOT_EQUAL, NONE};
+  for (CharClass single : {GREATER, OPENING_BRACKET, OPERATOR}) {
+    start[single] = {State::START, SINGLE};
+  }
 
-    case State::READING_CONSTANT:
-      if (std::isdigit(ch)) {
-        lexeme << ch;
-      } else if (std::isspace(ch)) {
-        _state = State::START;
+  // NOTE: identifier and constant are terminated by space, operator or
+  // beginning of '=' / '<' operator
+  for (auto [state, flush] :
+       {std::pair{State::READING_IDENTIFIER, FLUSH_IDENTIFIER},
+        std::pair{State::READING_CONSTANT, FLUSH_CONSTANT}}) {
+    auto &word = moves[state];
+    word[DIGIT] = {state, NONE};
+    for (CharClass terminating :
+         {SPACE, LESS, GREATER, OPENING_BRACKET, OPERATOR}) {
+      word[terminating] = {State::START, flush};
+    }
+  }
+
+  auto &identifier = moves[State::READING_IDENTIFIER];
+  identifier[LETTER] = {State::READING_IDENTIFIER, NONE};
+  identifier[EQUAL] = {State::START, FLUSH_IDENTIFIER};
+
+  // NOTE: '=' / '<' may be followed by second symbol of operator or by
+  // operand
+  for (auto [state, second] :
+       {std::pair{State::READING_OPERATOR_ASSIGNMENT_OR_EQUAL, EQUAL},
+        std::pair{State::READING_OPERATOR_LESS_OR_NOT_EQUAL, GREATER}}) {
+    auto &op = moves[state];
+    op[second] = {State::START, FLUSH_OPERATOR_WITH_CURRENT};
+    for (CharClass terminating : {SPACE, DIGIT, LETTER, OPENING_BRACKET}) {
+      op[terminating] = {State::START, FLUSH_OPERATOR};
+    }
+  }
+
+  return moves;
+}
+
+constexpr std::array<CharClass, 256> CHAR_CLASSES = MakeCharClasses();
+constexpr MovesTable MOVES = MakeMovesTable();
+
+const char *const ERROR_MESSAGES[STATES_COUNT] = {
+    "undefined symbol",           "undefined symbol",
+    "undefined symbol",           "incorrect literal symbol",
+    "incorrect identifier symbol", "undefined symbol",
+    "undefined symbol"};
 
-        lexemes.push_back({Lexeme::Type::UNDEFINED, Lexeme::Category::CONSTANT,
-                           lexeme.str()});
+} // namespace
 
-      } else if (EXACTLY_SINGLE_SYMBOL_OPERATOR.contains(ch)) {
-        _state = State::START;
+static const char *const SYNC_SYMBOLS = " \t\n\v\f\r;";
 
-        lexemes.push_back({Lexeme::Type::UNDEFINED, Lexeme::Category::CONSTANT,
-                           lexeme.str()});
-        lexemes.push_back(TERMINAL_LEXEMES.at(std::string(1, ch)));
-      } else if (ch == '<') {
-        std::string ready_made_lexeme = lexeme.str();
-        _state = State::READING_OPERATOR_LESS_OR_NOT_EQUAL;
+static std::string ErrorMessage(const char *error_message,
+                                const Lexeme &previous) {
+  return std::string("lexical error:") + error_message +
+         (previous.value.empty()
+              ? std::string(" at the beginning of text")
+              : " after '" + std::string(previous.value) + "' lexeme");
+}
 
-        lexemes.push_back({Lexeme::Type::UNDEFINED, Lexeme::Category::CONSTANT,
-                           lexeme.str()});
-      } else {
-        _state = State::ERROR;
+// NOTE: without diagnostics the first error is thrown as before
+bool LexicalAnalyzer::Scan(std::string_view text, bool is_last, Cursor &cursor,
+                           Lexeme &lexeme,
+                           std::vector<Diagnostic> *diagnostics) {
+  _state = State::START;
 
-        error_message = "incorrect literal symbol";
+  std::uint32_t row_number = cursor.line;
+  std::uint32_t col_number = cursor.column;
+
+  // NOTE: cursor is kept at the beginning of current (unfinished) lexeme
+
+  for (size_t i = cursor.offset; i < text.size(); ++i) {
+    const unsigned char ch = static_cast<unsigned char>(text[i]);
+    const CharClass char_class = CHAR_CLASSES[ch];
+
+    // NOTE: runs which keep the state are skipped in bulk, only whitespace
+    // may contain line breaks
+    if (_state == State::START && char_class == SPACE) {
+      const size_t run_end = SkipSpaces(text, i);
+      const std::string_view run = text.substr(i, run_end - i);
+      if (const size_t last_break = run.rfind('\n');
+          last_break != std::string_view::npos) {
+        row_number += static_cast<std::uint32_t>(
+            std::count(run.begin(), run.end(), '\n'));
+        col_number = 1;
+        i += last_break + 1;
       }
-      break;
+      col_number += static_cast<std::uint32_t>(run_end - i);
+      i = run_end - 1;
+      cursor = {run_end, row_number, col_number};
+      continue;
+    }
+    if ((_state == State::READING_IDENTIFIER &&
+         (char_class == LETTER || char_class == DIGIT)) ||
+        (_state == State::READING_CONSTANT && char_class == DIGIT)) {
+      const size_t run_end = _state == State::READING_IDENTIFIER
+                                 ? SkipLettersAndDigits(text, i)
+                                 : SkipDigits(text, i);
+      col_number += static_cast<std::uint32_t>(run_end - i);
+      i = run_end - 1;
+      continue;
+    }
 
-    case State::READING_OPERATOR_ASSIGNMENT_OR_EQUAL:
-      if (ch == '=') {
-        _state = State::START;
+    const Move move = MOVES[_state][char_class];
+
+    // NOTE: symbol which terminates lexeme is left for the next call, the
+    // start state moves on it exactly as the current one would
+    if (move.actions & (FLUSH_IDENTIFIER | FLUSH_CONSTANT)) {
+      lexeme = Word(move.actions & FLUSH_IDENTIFIER
+                        ? Lexeme::Category::IDENTIFIER
+                        : Lexeme::Category::CONSTANT,
+                    text.substr(cursor.offset, i - cursor.offset), cursor.line,
+                    cursor.column);
+      cursor = {i, row_number, col_number};
+      return true;
+    }
+    if (move.actions & FLUSH_OPERATOR) {
+      lexeme = Terminal(text.substr(cursor.offset, i - cursor.offset),
+                        cursor.line, cursor.column);
+      cursor = {i, row_number, col_number};
+      return true;
+    }
+    if (move.actions & FLUSH_OPERATOR_WITH_CURRENT) {
+      lexeme = Terminal(text.substr(cursor.offset, i - cursor.offset + 1),
+                        cursor.line, cursor.column);
+      cursor = {i + 1, row_number, col_number + 1};
+      return true;
+    }
+    if (move.actions & SINGLE) {
+      lexeme = Terminal(text.substr(i, 1), row_number, col_number);
+      cursor = {i + 1, row_number, col_number + 1};
+      return true;
+    }
 
-        lexemes.push_back(TERMINAL_LEXEMES.at("=="));
-      } else if (std::isspace(ch)) {
-        _state = State::START;
+    if (move.next == State::ERROR) {
+      const char *error_message = ERROR_MESSAGES[_state];
+      _state = State::START;
+
+      if (!diagnostics) {
+        throw std::to_string(row_number) + ":" + std::to_string(col_number) +
+            ": " + ErrorMessage(error_message, lexeme) + "\n";
+      }
+
+      // NOTE: only ';' may be erroneous symbol and synchronizing one at the
+      // same time, then it is left for the next lexeme
+      size_t sync = text.find_first_of(SYNC_SYMBOLS, i);
+      if (sync == std::string_view::npos) {
+        if (!is_last) {
+          return false;
+        }
+        sync = text.size();
+      }
 
-        lexemes.push_back(TERMINAL_LEXEMES.at("="));
-      } else if (std::isdigit(ch)) {
-        _state = State::READING_CONSTANT;
+      diagnostics->push_back(
+          {row_number, col_number, ErrorMessage(error_message, lexeme)});
+      lexeme = {Lexeme::Type::ERROR, Lexeme::Category::INVALID,
+                text.substr(cursor.offset, sync - cursor.offset), cursor.line,
+                cursor.column};
+      cursor = {sync, row_number,
+                col_number + static_cast<std::uint32_t>(sync - i)};
+      return true;
+    }
 
-        lexemes.push_back(TERMINAL_LEXEMES.at("="));
+    _state = move.next;
+    ++col_number;
+  }
 
-        lexeme.str("");
-        lexeme << ch;
-      } else if (std::isalpha(ch)) {
-        _state = State::READING_IDENTIFIER;
+  // NOTE: lexeme which is terminated by the end of text may be continued by
+  // the next chunk
+  if (_state == State::START || !is_last) {
+    _state = State::START;
+    return false;
+  }
 
-        lexemes.push_back(TERMINAL_LEXEMES.at("="));
+  const std::string_view value = text.substr(cursor.offset);
+
+  switch (_state) {
+  case State::READING_IDENTIFIER:
+    lexeme = Word(Lexeme::Category::IDENTIFIER, value, cursor.line,
+                  cursor.column);
+    break;
+  case State::READING_CONSTANT:
+    lexeme =
+        Word(Lexeme::Category::CONSTANT, value, cursor.line, cursor.column);
+    break;
+  default:
+    lexeme = Terminal(value, cursor.line, cursor.column);
+    break;
+  }
 
-        lexeme.str("");
-        lexeme << ch;
-      } else if (ch == '(') {
-        _state = State::START;
+  _state = State::START;
+  cursor = {text.size(), row_number, col_number};
+  return true;
+}
 
-        lexemes.push_back(TERMINAL_LEXEMES.at("="));
-        lexemes.push_back(TERMINAL_LEXEMES.at("("));
-      } else {
-        _state = State::ERROR;
+bool LexicalAnalyzer::Next(std::string_view text, bool is_last, Cursor &cursor,
+                           Lexeme &lexeme) {
+  return Scan(text, is_last, cursor, lexeme, nullptr);
+}
 
-        error_message = "undefined symbol";
-      }
-      break;
+bool LexicalAnalyzer::Next(std::string_view text, bool is_last, Cursor &cursor,
+                           Lexeme &lexeme,
+                           std::vector<Diagnostic> &diagnostics) {
+  return Scan(text, is_last, cursor, lexeme, &diagnostics);
+}
 
-    case State::READING_OPERATOR_LESS_OR_NOT_EQUAL:
-      if (ch == '>') {
-        _state = State::START;
+std::vector<Lexeme> LexicalAnalyzer::Analyse(std::string_view text) {
+  std::vector<Lexeme> lexemes;
 
-        lexemes.push_back(TERMINAL_LEXEMES.at("<>"));
-      } else if (std::isspace(ch)) {
-        _state = State::START;
+  Cursor cursor;
+  Lexeme lexeme{};
 
-        lexemes.push_back(TERMINAL_LEXEMES.at("<"));
-      } else if (std::isdigit(ch)) {
-        _state = State::READING_CONSTANT;
+  while (Next(text, true, cursor, lexeme)) {
+    lexemes.push_back(lexeme);
+  }
 
-        lexemes.push_back(TERMINAL_LEXEMES.at("<"));
+  return lexemes;
+}
 
-        lexeme.str("");
-        lexeme << ch;
-      } else if (std::isalpha(ch)) {
-        _state = State::READING_IDENTIFIER;
+TokenBuffer LexicalAnalyzer::Tokenize(std::string_view text) {
+  TokenBuffer tokens(text);
+  // NOTE: rough estimate, typical lexeme with separator is few symbols long
+  tokens.Reserve(text.size() / 4);
 
-        lexemes.push_back(TERMINAL_LEXEMES.at("<"));
+  Cursor cursor;
+  Lexeme lexeme{};
 
-        lexeme.str("");
-        lexeme << ch;
-      } else if (ch == '(') {
-        _state = State::START;
+  while (Next(text, true, cursor, lexeme)) {
+    tokens.Append(lexeme);
+  }
 
-        lexemes.push_back(TERMINAL_LEXEMES.at("<"));
-        lexemes.push_back(TERMINAL_LEXEMES.at("("));
-      } else {
-        _state = State::ERROR;
+  return tokens;
+}
 
-        error_message = "undefined symbol";
-      }
-      break;
-    }
+void LexicalAnalyzer::Tokenize(std::string_view text, TokenBuffer &tokens,
+                               std::vector<Diagnostic> &diagnostics) {
+  tokens.Reset(text);
+  tokens.Reserve(text.size() / 4);
 
-    if (_state == State::ERROR) {
-      _state = State::START;
-      throw std::to_string(row_number) + ":" + std::to_string(col_number) +
-          ": lexical error:" + error_message + " after '" +
-          (lexemes.end() - 1)->value + "' lexeme" + "\n";
-    }
+  Cursor cursor;
+  Lexeme lexeme{};
 
-    ++col_number;
+  while (Next(text, true, cursor, lexeme, diagnostics)) {
+    tokens.Append(lexeme);
   }
+}
 
-  lexemes.push_back(TERMINAL_LEXEMES.contains(lexeme.str())
-                        ? TERMINAL_LEXEMES.at(lexeme.str())
-                        : Lexeme{Lexeme::Type::UNDEFINED,
-                                 _state == State::READING_IDENTIFIER
-                                     ? Lexeme::Category::IDENTIFIER
-                                     : Lexeme::Category::CONSTANT,
-                                 lexeme.str()});
+AnalysisResult LexicalAnalyzer::AnalyseRecovering(std::string_view text) {
+  AnalysisResult result;
 
-  _state = State::START;
-  return lexemes;
+  Cursor cursor;
+  Lexeme lexeme{};
+
+  while (Next(text, true, cursor, lexeme, result.diagnostics)) {
+    result.lexemes.push_back(lexeme);
+  }
+
+  return result;
 }
@@ -2,16 +2,66 @@
 
 #include "lexeme.h"
 #include "state.h"
-#include <filesystem>
+#include "tokens.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
 #include <vector>
 
+struct Diagnostic {
+  std::uint32_t line = 0;
+  std::uint32_t column = 0;
+  std::string message;
+};
+
+// NOTE: diagnostic without message positioned at `offset` of `text`, for
+// errors found after analysis
+Diagnostic Locate(std::string_view text, std::size_t offset);
+
+struct AnalysisResult {
+  std::vector<Lexeme> lexemes;
+  std::vector<Diagnostic> diagnostics;
+};
+
 class LexicalAnalyzer {
 public:
-  std::vector<Lexeme> Analyse(const std::string &text);
+  // NOTE: position of the next symbol to scan
+  struct Cursor {
+    std::size_t offset = 0;
+    std::uint32_t line = 1;
+    std::uint32_t column = 1;
+  };
+
+  std::vector<Lexeme> Analyse(std::string_view text);
+
+  // NOTE: same as Analyse, but lexemes are stored in compact arrays; with
+  // diagnostics errors are collected as in AnalyseRecovering, and tokens are
+  // written into given buffer, which is reused
+  TokenBuffer Tokenize(std::string_view text);
+  void Tokenize(std::string_view text, TokenBuffer &tokens,
+                std::vector<Diagnostic> &diagnostics);
+
+  // NOTE: never throws, every erroneous lexeme is reported and returned as
+  // ERROR lexeme, analysis resumes after the next whitespace or ';'
+  AnalysisResult AnalyseRecovering(std::string_view text);
+
+  // NOTE: scans one lexeme from cursor into `lexeme`, whose previous value is
+  // used in error message. Returns false when text is exhausted; unless
+  // `is_last`, cursor is left at the beginning of unfinished lexeme, so it
+  // can be rescanned once text is continued
+  bool Next(std::string_view text, bool is_last, Cursor &cursor,
+            Lexeme &lexeme);
+  bool Next(std::string_view text, bool is_last, Cursor &cursor,
+            Lexeme &lexeme, std::vector<Diagnostic> &diagnostics);
 
 public:
   LexicalAnalyzer();
 
+private:
+  bool Scan(std::string_view text, bool is_last, Cursor &cursor,
+            Lexeme &lexeme, std::vector<Diagnostic> *diagnostics);
+
 private:
   State _state;
 };
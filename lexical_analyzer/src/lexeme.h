@@ -1,8 +1,8 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
-#include <string>
-#include <unordered_map>
+#include <string_view>
 
 struct Lexeme {
   enum Type {
@@ -21,38 +21,69 @@ struct Lexeme {
     OUTPUT,
     BRACKET,
     SEPARATOR,
-    UNDEFINED
+    UNDEFINED,
+    ERROR
   } type;
-  enum Category { KEYWORD, SPECIAL_SYMBOL, IDENTIFIER, CONSTANT } category;
-  std::string value;
+  enum Category {
+    KEYWORD,
+    SPECIAL_SYMBOL,
+    IDENTIFIER,
+    CONSTANT,
+    INVALID
+  } category;
+  // NOTE: view into the analysed text (or into static keyword table), text
+  // must outlive lexemes
+  std::string_view value;
+  std::uint32_t line = 0;
+  std::uint32_t column = 0;
 };
 
-const std::unordered_map<std::string, Lexeme> TERMINAL_LEXEMES{
-    {"if", {Lexeme::Type::IF, Lexeme::Category::KEYWORD, "if"}},
-    {"then", {Lexeme::Type::THEN, Lexeme::Category::KEYWORD, "then"}},
-    {"end", {Lexeme::Type::END, Lexeme::Category::KEYWORD, "end"}},
-    {"elseif", {Lexeme::Type::ELSEIF, Lexeme::Category::KEYWORD, "elseif"}},
-    {"else", {Lexeme::Type::ELSE, Lexeme::Category::KEYWORD, "else"}},
-    {"and", {Lexeme::Type::AND, Lexeme::Category::KEYWORD, "and"}},
-    {"or", {Lexeme::Type::OR, Lexeme::Category::KEYWORD, "or"}},
-    {"<", {Lexeme::Type::RELATION, Lexeme::Category::SPECIAL_SYMBOL, "<"}},
-    {">", {Lexeme::Type::RELATION, Lexeme::Category::SPECIAL_SYMBOL, ">"}},
-    {"==", {Lexeme::Type::RELATION, Lexeme::Category::SPECIAL_SYMBOL, "=="}},
-    {"<>", {Lexeme::Type::RELATION, Lexeme::Category::SPECIAL_SYMBOL, "<>"}},
-    {"+",
-     {Lexeme::Type::ARITHMETIC_SIMPLE, Lexeme::Category::SPECIAL_SYMBOL, "+"}},
-    {"-",
-     {Lexeme::Type::ARITHMETIC_SIMPLE, Lexeme::Category::SPECIAL_SYMBOL, "-"}},
-    {"*",
-     {Lexeme::Type::ARITHMETIC_DIFICULT, Lexeme::Category::SPECIAL_SYMBOL,
-      "*"}},
-    {"/",
-     {Lexeme::Type::ARITHMETIC_DIFICULT, Lexeme::Category::SPECIAL_SYMBOL,
-      "/"}},
-    {"=", {Lexeme::Type::ASSIGNMENT, Lexeme::Category::SPECIAL_SYMBOL, "="}},
-    {"input", {Lexeme::Type::INPUT, Lexeme::Category::KEYWORD, "input"}},
-    {"output", {Lexeme::Type::OUTPUT, Lexeme::Category::KEYWORD, "output"}},
-    {"(", {Lexeme::Type::BRACKET, Lexeme::Category::SPECIAL_SYMBOL, "("}},
-    {")", {Lexeme::Type::BRACKET, Lexeme::Category::SPECIAL_SYMBOL, ")"}},
-    {";", {Lexeme::Type::SEPARATOR, Lexeme::Category::SPECIAL_SYMBOL, ";"}},
+struct Keyword {
+  std::string_view text;
+  Lexeme::Type type = Lexeme::Type::UNDEFINED;
 };
+
+// NOTE: perfect hash of the fixed keyword set by length, first and last
+// letters, collisions are rejected while building table at compile time
+constexpr std::size_t KEYWORDS_TABLE_SIZE = 16;
+
+constexpr std::size_t KeywordHash(std::string_view word) {
+  return (word.size() + 3 * static_cast<unsigned char>(word.front()) +
+          static_cast<unsigned char>(word.back())) %
+         KEYWORDS_TABLE_SIZE;
+}
+
+constexpr std::array<Keyword, KEYWORDS_TABLE_SIZE> MakeKeywordsTable() {
+  std::array<Keyword, KEYWORDS_TABLE_SIZE> table{};
+
+  for (const Keyword &keyword : {Keyword{"if", Lexeme::Type::IF},
+                                 Keyword{"then", Lexeme::Type::THEN},
+                                 Keyword{"end", Lexeme::Type::END},
+                                 Keyword{"elseif", Lexeme::Type::ELSEIF},
+                                 Keyword{"else", Lexeme::Type::ELSE},
+                                 Keyword{"and", Lexeme::Type::AND},
+                                 Keyword{"or", Lexeme::Type::OR},
+                                 Keyword{"input", Lexeme::Type::INPUT},
+                                 Keyword{"output", Lexeme::Type::OUTPUT}}) {
+    Keyword &slot = table[KeywordHash(keyword.text)];
+    if (!slot.text.empty()) {
+      throw "Exception: keywords hash collision";
+    }
+    slot = keyword;
+  }
+
+  return table;
+}
+
+constexpr std::array<Keyword, KEYWORDS_TABLE_SIZE> KEYWORDS =
+    MakeKeywordsTable();
+
+// NOTE: returns UNDEFINED for identifiers which are not keywords
+constexpr Lexeme::Type KeywordType(std::string_view word) {
+  if (word.size() < 2 || word.size() > 6) {
+    return Lexeme::Type::UNDEFINED;
+  }
+
+  const Keyword &keyword = KEYWORDS[KeywordHash(word)];
+  return keyword.text == word ? keyword.type : Lexeme::Type::UNDEFINED;
+}
@@ -1,5 +1,10 @@
 #include "analyzer.h"
+#include "parallel.h"
+#include "stream.h"
+#include <charconv>
+#include <cstring>
 #include <iostream>
+#include <optional>
 #include <unordered_map>
 
 const std::unordered_map<Lexeme::Type, std::string> TYPES{
@@ -19,6 +24,7 @@ const std::unordered_map<Lexeme::Type, std::string> TYPES{
     {Lexeme::Type::BRACKET, "BRACKET"},
     {Lexeme::Type::SEPARATOR, "SEPARATOR"},
     {Lexeme::Type::UNDEFINED, "UNDEFINED"},
+    {Lexeme::Type::ERROR, "ERROR"},
 };
 
 const std::unordered_map<Lexeme::Category, std::string> CATEGORIES{
@@ -26,22 +32,83 @@ const std::unordered_map<Lexeme::Category, std::string> CATEGORIES{
     {Lexeme::Category::SPECIAL_SYMBOL, "SPECIAL_SYMBOL"},
     {Lexeme::Category::IDENTIFIER, "IDENTIFIER"},
     {Lexeme::Category::CONSTANT, "CONSTANT"},
+    {Lexeme::Category::INVALID, "INVALID"},
 };
 
+static void Print(const Lexeme &lexeme) {
+  std::cout << lexeme.value << "\t\t\t" << TYPES.at(lexeme.type)
+            << (TYPES.at(lexeme.type).length() < 8    ? "\t\t\t"
+                : TYPES.at(lexeme.type).length() > 11 ? "\t"
+                                                      : "\t\t")
+            << CATEGORIES.at(lexeme.category) << "\n";
+}
+
+// NOTE: whole argument must be decimal number
+static bool Number(const char *argument, unsigned &value) {
+  const char *end = argument + std::strlen(argument);
+  auto [last, error] = std::from_chars(argument, end, value);
+  return error == std::errc() && last == end && last != argument;
+}
+
 int main(int argc, char **argv) {
   LexicalAnalyzer analyzer;
 
   try {
-    auto lexemes = analyzer.Analyse(argv[1]);
+    // NOTE: `-f <path>` streams program from file ('-' for stdin) instead of
+    // taking its text from argument
+    if (argc > 2 && std::string(argv[1]) == "-f") {
+      std::string path = argv[2];
+      std::optional<LexemeStream> stream;
+      if (path == "-") {
+        stream.emplace(0);
+      } else {
+        stream.emplace(LexemeStream::File{path});
+      }
+
+      std::cout << "VALUE" << "\t\t\t" << "TYPE" << "\t\t\t" << "CATEGORY"
+                << "\n";
+      while (auto lexeme = stream->NextToken()) {
+        Print(*lexeme);
+      }
+      return 0;
+    }
+
+    // NOTE: `-r <program>` reports every lexical error instead of stopping
+    // at the first one
+    if (argc > 2 && std::string(argv[1]) == "-r") {
+      AnalysisResult result = analyzer.AnalyseRecovering(argv[2]);
+
+      std::cout << "VALUE" << "\t\t\t" << "TYPE" << "\t\t\t" << "CATEGORY"
+                << "\n";
+      for (const Lexeme &lexeme : result.lexemes) {
+        Print(lexeme);
+      }
+      for (const Diagnostic &diagnostic : result.diagnostics) {
+        std::cerr << diagnostic.line << ":" << diagnostic.column << ": "
+                  << diagnostic.message << std::endl;
+      }
+      return result.diagnostics.empty() ? 0 : 1;
+    }
+
+    // NOTE: `-j <threads> <program>` lexes program by chunks in parallel on
+    // given positive number of threads
+    bool parallel = argc > 3 && std::string(argv[1]) == "-j";
+    unsigned threads = 0;
+    if (parallel && !(Number(argv[2], threads) && threads > 0)) {
+      std::cerr << "usage: lexer -j <threads> <program>, threads is a "
+                   "positive decimal number"
+                << std::endl;
+      return 2;
+    }
+
+    std::vector<Lexeme> lexemes = parallel
+                                      ? AnalyseParallel(argv[3], threads)
+                                      : analyzer.Analyse(argv[1]);
 
     std::cout << "VALUE" << "\t\t\t" << "TYPE" << "\t\t\t" << "CATEGORY"
               << "\n";
     for (auto lexeme : lexemes) {
-      std::cout << lexeme.value << "\t\t\t" << TYPES.at(lexeme.type)
-                << (TYPES.at(lexeme.type).length() < 8    ? "\t\t\t"
-                    : TYPES.at(lexeme.type).length() > 11 ? "\t"
-                                                          : "\t\t")
-                << CATEGORIES.at(lexeme.category) << "\n";
+      Print(lexeme);
     }
   } catch (std::string exception) {
     std::cerr << exception << std::endl;
@@ -0,0 +1,140 @@
+#include "parallel.h"
+#include "analyzer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+static const std::size_t MIN_CHUNK_SIZE = 1 << 16;
+static const std::size_t CHUNKS_PER_THREAD = 4;
+
+namespace {
+
+struct Chunk {
+  Chunk(std::size_t begin, std::size_t end) : begin(begin), end(end) {}
+
+  std::size_t begin = 0;
+  std::size_t end = 0;
+  std::vector<Lexeme> lexemes;
+  // NOTE: line breaks and length of the last line, for positions fix-up
+  std::uint32_t lines = 0;
+  std::size_t tail = 0;
+  bool failed = false;
+};
+
+} // namespace
+
+static std::vector<Chunk> Split(std::string_view text, std::size_t count) {
+  std::vector<Chunk> chunks;
+  std::size_t begin = 0;
+
+  for (std::size_t k = 1; k < count; ++k) {
+    std::size_t position = std::max(k * text.size() / count, begin);
+    std::size_t boundary = text.find_first_of(" \t\n\v\f\r;", position);
+
+    if (boundary == std::string_view::npos) {
+      break;
+    }
+
+    chunks.emplace_back(begin, boundary + 1);
+    begin = boundary + 1;
+  }
+
+  chunks.emplace_back(begin, text.size());
+
+  return chunks;
+}
+
+static void AnalyseChunk(std::string_view text, Chunk &chunk) {
+  const std::string_view part =
+      text.substr(chunk.begin, chunk.end - chunk.begin);
+
+  chunk.lines =
+      static_cast<std::uint32_t>(std::count(part.begin(), part.end(), '\n'));
+  const std::size_t last_break = part.rfind('\n');
+  chunk.tail = last_break == std::string_view::npos
+                   ? part.size()
+                   : part.size() - last_break - 1;
+
+  LexicalAnalyzer analyzer;
+  LexicalAnalyzer::Cursor cursor{chunk.begin, 1, 1};
+  Lexeme lexeme{};
+
+  try {
+    while (analyzer.Next(text.substr(0, chunk.end), true, cursor, lexeme)) {
+      chunk.lexemes.push_back(lexeme);
+    }
+  } catch (std::string) {
+    chunk.failed = true;
+  }
+}
+
+std::vector<Lexeme> AnalyseParallel(std::string_view text, unsigned threads) {
+  if (threads == 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+
+  const std::size_t count = std::min<std::size_t>(
+      threads * CHUNKS_PER_THREAD, text.size() / MIN_CHUNK_SIZE);
+
+  if (threads == 1 || count < 2) {
+    return LexicalAnalyzer().Analyse(text);
+  }
+
+  std::vector<Chunk> chunks = Split(text, count);
+  std::atomic<std::size_t> next_chunk = 0;
+
+  std::vector<std::thread> workers;
+  for (unsigned i = 0; i < std::min<std::size_t>(threads, chunks.size()); ++i) {
+    workers.emplace_back([&] {
+      for (std::size_t k = next_chunk++; k < chunks.size(); k = next_chunk++) {
+        AnalyseChunk(text, chunks[k]);
+      }
+    });
+  }
+
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+
+  std::size_t total = 0;
+  for (const Chunk &chunk : chunks) {
+    total += chunk.lexemes.size();
+  }
+
+  std::vector<Lexeme> lexemes;
+  lexemes.reserve(total);
+
+  std::uint32_t line = 1;
+  std::uint32_t column = 1;
+
+  for (const Chunk &chunk : chunks) {
+    // NOTE: chunk is rescanned from its absolute position, so error is
+    // reported exactly as by sequential analysis
+    if (chunk.failed) {
+      LexicalAnalyzer analyzer;
+      LexicalAnalyzer::Cursor cursor{chunk.begin, line, column};
+      Lexeme lexeme = lexemes.empty() ? Lexeme{} : lexemes.back();
+
+      while (analyzer.Next(text.substr(0, chunk.end), true, cursor, lexeme)) {
+      }
+    }
+
+    for (Lexeme lexeme : chunk.lexemes) {
+      if (lexeme.line == 1) {
+        lexeme.column += column - 1;
+      }
+      lexeme.line += line - 1;
+      lexemes.push_back(lexeme);
+    }
+
+    if (chunk.lines) {
+      line += chunk.lines;
+      column = 1;
+    }
+    column += static_cast<std::uint32_t>(chunk.tail);
+  }
+
+  return lexemes;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "lexeme.h"
+
+#include <string_view>
+#include <vector>
+
+// NOTE: splits text into chunks right after whitespace or ';' (the start
+// state is restored there whatever precedes), lexes them on `threads` workers
+// (0 is for hardware concurrency) and concatenates lexemes with positions
+// fixed up. Result and errors are the same as of LexicalAnalyzer::Analyse
+std::vector<Lexeme> AnalyseParallel(std::string_view text,
+                                    unsigned threads = 0);
@@ -0,0 +1,156 @@
+#include "scan.h"
+
+#include <bit>
+#include <cstdint>
+
+#if !defined(LEXER_NO_SIMD) && defined(__AVX2__)
+#include <immintrin.h>
+#define LEXER_SIMD
+#elif !defined(LEXER_NO_SIMD) && defined(__SSE2__)
+#include <emmintrin.h>
+#define LEXER_SIMD
+#endif
+
+static bool IsSpace(unsigned char ch) {
+  return ch == ' ' || (ch >= '\t' && ch <= '\r');
+}
+
+static bool IsDigit(unsigned char ch) { return ch >= '0' && ch <= '9'; }
+
+static bool IsLetter(unsigned char ch) {
+  return (ch | 0x20) >= 'a' && (ch | 0x20) <= 'z';
+}
+
+#if defined(LEXER_SIMD)
+
+namespace {
+
+#if defined(__AVX2__)
+
+using Vector = __m256i;
+constexpr std::size_t VECTOR_SIZE = 32;
+
+Vector Load(const char *data) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+}
+Vector Splat(char ch) { return _mm256_set1_epi8(ch); }
+Vector Equal(Vector first, Vector second) {
+  return _mm256_cmpeq_epi8(first, second);
+}
+Vector Greater(Vector first, Vector second) {
+  return _mm256_cmpgt_epi8(first, second);
+}
+Vector And(Vector first, Vector second) {
+  return _mm256_and_si256(first, second);
+}
+Vector Or(Vector first, Vector second) {
+  return _mm256_or_si256(first, second);
+}
+std::uint32_t Mask(Vector vector) {
+  return static_cast<std::uint32_t>(_mm256_movemask_epi8(vector));
+}
+
+#else
+
+using Vector = __m128i;
+constexpr std::size_t VECTOR_SIZE = 16;
+
+Vector Load(const char *data) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+}
+Vector Splat(char ch) { return _mm_set1_epi8(ch); }
+Vector Equal(Vector first, Vector second) {
+  return _mm_cmpeq_epi8(first, second);
+}
+Vector Greater(Vector first, Vector second) {
+  return _mm_cmpgt_epi8(first, second);
+}
+Vector And(Vector first, Vector second) { return _mm_and_si128(first, second); }
+Vector Or(Vector first, Vector second) { return _mm_or_si128(first, second); }
+std::uint32_t Mask(Vector vector) {
+  return static_cast<std::uint32_t>(_mm_movemask_epi8(vector));
+}
+
+#endif
+
+constexpr std::uint32_t FULL_MASK =
+    static_cast<std::uint32_t>((std::uint64_t{1} << VECTOR_SIZE) - 1);
+
+// NOTE: comparisons are signed, so bytes >= 0x80 never fall into ranges
+Vector InRange(Vector block, char low, char high) {
+  return And(Greater(block, Splat(low - 1)), Greater(Splat(high + 1), block));
+}
+
+Vector Spaces(Vector block) {
+  return Or(Equal(block, Splat(' ')), InRange(block, '\t', '\r'));
+}
+
+Vector Digits(Vector block) { return InRange(block, '0', '9'); }
+
+Vector Letters(Vector block) {
+  return InRange(Or(block, Splat(0x20)), 'a', 'z');
+}
+
+Vector LettersAndDigits(Vector block) {
+  return Or(Letters(block), Digits(block));
+}
+
+// NOTE: stops at the first symbol outside of run or before the tail which is
+// shorter than block
+template <typename Predicate>
+std::size_t SkipBlocks(std::string_view text, std::size_t position,
+                       Predicate in_run) {
+  for (; position + VECTOR_SIZE <= text.size(); position += VECTOR_SIZE) {
+    std::uint32_t outside =
+        ~Mask(in_run(Load(text.data() + position))) & FULL_MASK;
+    if (outside) {
+      return position + std::countr_zero(outside);
+    }
+  }
+
+  return position;
+}
+
+} // namespace
+
+#endif
+
+std::size_t SkipSpaces(std::string_view text, std::size_t position) {
+#if defined(LEXER_SIMD)
+  position = SkipBlocks(text, position, Spaces);
+#endif
+
+  while (position < text.size() &&
+         IsSpace(static_cast<unsigned char>(text[position]))) {
+    ++position;
+  }
+
+  return position;
+}
+
+std::size_t SkipLettersAndDigits(std::string_view text, std::size_t position) {
+#if defined(LEXER_SIMD)
+  position = SkipBlocks(text, position, LettersAndDigits);
+#endif
+
+  while (position < text.size() &&
+         (IsLetter(static_cast<unsigned char>(text[position])) ||
+          IsDigit(static_cast<unsigned char>(text[position])))) {
+    ++position;
+  }
+
+  return position;
+}
+
+std::size_t SkipDigits(std::string_view text, std::size_t position) {
+#if defined(LEXER_SIMD)
+  position = SkipBlocks(text, position, Digits);
+#endif
+
+  while (position < text.size() &&
+         IsDigit(static_cast<unsigned char>(text[position]))) {
+    ++position;
+  }
+
+  return position;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+// NOTE: each function returns position of the first symbol at or after
+// `position` which does not belong to the run. Runs are scanned by SSE2 or
+// AVX2 blocks when the compiler targets them (e.g. -mavx2 or -march=native),
+// define LEXER_NO_SIMD to force scalar loops.
+
+std::size_t SkipSpaces(std::string_view text, std::size_t position);
+
+std::size_t SkipLettersAndDigits(std::string_view text, std::size_t position);
+
+std::size_t SkipDigits(std::string_view text, std::size_t position);
@@ -0,0 +1,88 @@
+#include "stream.h"
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+LexemeStream::LexemeStream(std::string_view text) : _text(text) {}
+
+LexemeStream::LexemeStream(int descriptor, std::size_t chunk_size)
+    : _is_last(false), _descriptor(descriptor),
+      _chunk_size(chunk_size ? chunk_size : 1) {}
+
+LexemeStream::LexemeStream(const File &file) {
+  _descriptor = open(file.path.c_str(), O_RDONLY);
+  if (_descriptor < 0) {
+    throw "can't open '" + file.path + "': " + std::strerror(errno) + "\n";
+  }
+  _owns_descriptor = true;
+
+  struct stat status;
+  if (fstat(_descriptor, &status) == 0 && S_ISREG(status.st_mode)) {
+    if (status.st_size == 0) {
+      return;
+    }
+
+    void *mapping = mmap(nullptr, static_cast<std::size_t>(status.st_size),
+                         PROT_READ, MAP_PRIVATE, _descriptor, 0);
+    if (mapping != MAP_FAILED) {
+      _mapping = mapping;
+      _mapping_size = static_cast<std::size_t>(status.st_size);
+      _text = {static_cast<const char *>(_mapping), _mapping_size};
+      madvise(_mapping, _mapping_size, MADV_SEQUENTIAL);
+      return;
+    }
+  }
+
+  _is_last = false;
+  _chunk_size = 1 << 16;
+}
+
+LexemeStream::~LexemeStream() {
+  if (_mapping) {
+    munmap(_mapping, _mapping_size);
+  }
+  if (_owns_descriptor) {
+    close(_descriptor);
+  }
+}
+
+std::optional<Lexeme> LexemeStream::NextToken() {
+  while (!_analyzer.Next(_text, _is_last, _cursor, _last)) {
+    if (_is_last) {
+      return std::nullopt;
+    }
+    Fill();
+  }
+
+  return _last;
+}
+
+// NOTE: drops scanned part of buffer and appends next chunk after the
+// unfinished lexeme, cursor positions stay absolute
+void LexemeStream::Fill() {
+  _previous.assign(_last.value);
+  _last.value = _previous;
+
+  _buffer.erase(0, _cursor.offset);
+  _cursor.offset = 0;
+
+  const std::size_t size = _buffer.size();
+  _buffer.resize(size + _chunk_size);
+
+  ssize_t count;
+  do {
+    count = read(_descriptor, _buffer.data() + size, _chunk_size);
+  } while (count < 0 && errno == EINTR);
+
+  if (count < 0) {
+    throw std::string("can't read input: ") + std::strerror(errno) + "\n";
+  }
+
+  _buffer.resize(size + static_cast<std::size_t>(count));
+  _is_last = count == 0;
+  _text = _buffer;
+}
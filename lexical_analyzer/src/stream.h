@@ -0,0 +1,54 @@
+#pragma once
+
+#include "analyzer.h"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+// NOTE: pull-based lexer over a whole buffer, a mapped file or a descriptor
+// read by chunks. Memory stays bounded by chunk size plus the longest lexeme.
+// Values of lexemes from descriptor point into internal buffer and are valid
+// until the next call of NextToken, in other modes they live as long as the
+// stream (or the given text)
+class LexemeStream {
+public:
+  // NOTE: tag which tells path from program text
+  struct File {
+    std::string path;
+  };
+
+public:
+  explicit LexemeStream(std::string_view text);
+  explicit LexemeStream(int descriptor, std::size_t chunk_size = 1 << 16);
+  // NOTE: maps the file, falls back to reading by chunks if it can't be mapped
+  explicit LexemeStream(const File &file);
+
+  LexemeStream(const LexemeStream &) = delete;
+  LexemeStream &operator=(const LexemeStream &) = delete;
+
+  ~LexemeStream();
+
+  std::optional<Lexeme> NextToken();
+
+private:
+  void Fill();
+
+private:
+  LexicalAnalyzer _analyzer;
+  LexicalAnalyzer::Cursor _cursor;
+  Lexeme _last{};
+  std::string _previous;
+
+  std::string_view _text;
+  bool _is_last = true;
+
+  std::string _buffer;
+  int _descriptor = -1;
+  bool _owns_descriptor = false;
+  std::size_t _chunk_size = 0;
+
+  void *_mapping = nullptr;
+  std::size_t _mapping_size = 0;
+};
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "lexeme.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// NOTE: lexemes stored as parallel arrays, values are kept as offsets into
+// the analysed text, which must outlive the buffer. Reading past the last
+// token yields empty UNDEFINED token, so parsers may look ahead freely
+class TokenBuffer {
+public:
+  using Index = std::size_t;
+
+public:
+  TokenBuffer() = default;
+  explicit TokenBuffer(std::string_view text) : _text(text) {}
+
+  // NOTE: drops tokens but keeps capacity, so buffer may be refilled from
+  // another text without allocations
+  void Reset(std::string_view text) {
+    _text = text;
+    _types.clear();
+    _categories.clear();
+    _offsets.clear();
+    _lengths.clear();
+  }
+
+  void Reserve(std::size_t size) {
+    _types.reserve(size);
+    _categories.reserve(size);
+    _offsets.reserve(size);
+    _lengths.reserve(size);
+  }
+
+  void Append(const Lexeme &lexeme) {
+    _types.push_back(static_cast<std::uint8_t>(lexeme.type));
+    _categories.push_back(static_cast<std::uint8_t>(lexeme.category));
+    _offsets.push_back(
+        static_cast<std::uint32_t>(lexeme.value.data() - _text.data()));
+    _lengths.push_back(static_cast<std::uint32_t>(lexeme.value.size()));
+  }
+
+  // NOTE: replaces tokens [first, last) with all tokens of `other`, which is
+  // built over the same `text`, and moves offsets of the following ones by
+  // `shift`. Used to patch buffer after text is edited
+  void Splice(std::string_view text, Index first, Index last,
+              const TokenBuffer &other, std::ptrdiff_t shift) {
+    _text = text;
+    for (Index index = last; shift != 0 && index < _offsets.size(); ++index) {
+      _offsets[index] = static_cast<std::uint32_t>(_offsets[index] + shift);
+    }
+
+    Replace(_types, first, last, other._types);
+    Replace(_categories, first, last, other._categories);
+    Replace(_offsets, first, last, other._offsets);
+    Replace(_lengths, first, last, other._lengths);
+  }
+
+  std::size_t Size() const { return _types.size(); }
+
+  Lexeme::Type Type(Index index) const {
+    return index < _types.size() ? static_cast<Lexeme::Type>(_types[index])
+                                 : Lexeme::Type::UNDEFINED;
+  }
+
+  Lexeme::Category Category(Index index) const {
+    return index < _categories.size()
+               ? static_cast<Lexeme::Category>(_categories[index])
+               : Lexeme::Category::INVALID;
+  }
+
+  std::string_view Value(Index index) const {
+    return index < _offsets.size()
+               ? _text.substr(_offsets[index], _lengths[index])
+               : std::string_view();
+  }
+
+  std::uint32_t Offset(Index index) const { return _offsets[index]; }
+  std::uint32_t Length(Index index) const { return _lengths[index]; }
+
+private:
+  // NOTE: overlapping part is overwritten, so tail is moved at most once
+  // and not at all when edit keeps the number of tokens
+  template <typename T>
+  static void Replace(std::vector<T> &values, Index first, Index last,
+                      const std::vector<T> &other) {
+    Index common = std::min(last - first, other.size());
+    std::copy_n(other.begin(), common, values.begin() + first);
+    values.erase(values.begin() + first + common, values.begin() + last);
+    values.insert(values.begin() + first + common, other.begin() + common,
+                  other.end());
+  }
+
+private:
+  std::string_view _text;
+  std::vector<std::uint8_t> _types;
+  std::vector<std::uint8_t> _categories;
+  std::vector<std::uint32_t> _offsets;
+  std::vector<std::uint32_t> _lengths;
+};
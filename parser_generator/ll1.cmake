@@ -0,0 +1,38 @@
+# NOTE: builds ll1 generator as host tool; target_ll1_grammar(<target>
+# <grammar>) makes header <stem>.h with LL(1) table of grammar, generated at
+# build time, includable by <target> and targets linking it together with
+# driver ll1.h
+
+set(LL1_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+if(NOT TARGET ll1)
+  add_executable(ll1
+    ${LL1_DIR}/src/main.cpp
+
+    ${LL1_DIR}/src/grammar.cpp
+    ${LL1_DIR}/src/codegen.cpp
+    ${LL1_DIR}/src/out.cpp
+
+    ${LL1_DIR}/src/grammar.h
+    ${LL1_DIR}/src/codegen.h
+    ${LL1_DIR}/src/out.h
+  )
+
+  target_compile_options(ll1 PRIVATE -std=c++20)
+endif()
+
+function(target_ll1_grammar target grammar)
+  get_filename_component(stem ${grammar} NAME_WE)
+  set(directory ${CMAKE_CURRENT_BINARY_DIR}/generated)
+
+  add_custom_command(
+    OUTPUT ${directory}/${stem}.h
+    COMMAND ${CMAKE_COMMAND} -E make_directory ${directory}
+    COMMAND ll1 ${grammar} ${directory}/${stem}
+    DEPENDS ll1 ${grammar}
+    COMMENT "Generating LL(1) table of ${stem}"
+  )
+
+  target_sources(${target} PRIVATE ${directory}/${stem}.h ${LL1_DIR}/src/ll1.h)
+  target_include_directories(${target} PUBLIC ${directory})
+endfunction()
@@ -0,0 +1,164 @@
+#include "codegen.h"
+
+#include <cctype>
+
+static const char *KINDS[] = {"TERMINAL", "NONTERMINAL", "ACTION"};
+
+static std::string Identifier(const std::string &stem) {
+  std::string identifier;
+
+  for (char ch : stem) {
+    identifier += std::isalnum(static_cast<unsigned char>(ch)) ? ch : '_';
+  }
+
+  if (!Grammar::IsIdentifier(identifier)) {
+    identifier.insert(0, "grammar_");
+  }
+
+  return identifier;
+}
+
+static std::string Name(const Grammar &grammar, const Grammar::Symbol &symbol) {
+  switch (symbol.kind) {
+  case Grammar::Symbol::TERMINAL:
+    return grammar.terminals[symbol.id];
+  case Grammar::Symbol::NONTERMINAL:
+    return grammar.nonterminals[symbol.id];
+  case Grammar::Symbol::ACTION:
+    break;
+  }
+  return '@' + grammar.actions[symbol.id];
+}
+
+static void GenerateEnum(const char *name,
+                         const std::vector<std::string> &enumerators,
+                         std::ostream &header) {
+  header << "enum class " << name << " : std::uint8_t {\n";
+  for (const std::string &enumerator : enumerators) {
+    header << "  " << enumerator << ",\n";
+  }
+  header << "};\n\n";
+}
+
+static void GenerateNames(const char *name,
+                          const std::vector<std::string> &names,
+                          std::ostream &header) {
+  header << "constexpr const char *" << name << "[] = {\n";
+  for (const std::string &value : names) {
+    header << "    \"" << value << "\",\n";
+  }
+  header << "};\n\n";
+}
+
+static void GenerateProductions(const Grammar &grammar, std::ostream &header) {
+  header << "constexpr Symbol RIGHT_SIDES[] = {\n";
+
+  for (std::size_t i = 0; i < grammar.productions.size(); ++i) {
+    const Grammar::Production &production = grammar.productions[i];
+
+    header << "    // " << i << ": " << grammar.nonterminals[production.left]
+           << " ->";
+    for (const Grammar::Symbol &symbol : production.right) {
+      header << ' ' << Name(grammar, symbol);
+    }
+    header << (production.right.empty() ? " eps\n" : "\n");
+
+    for (const Grammar::Symbol &symbol : production.right) {
+      header << "    {Symbol::" << KINDS[symbol.kind] << ", " << symbol.id
+             << "},\n";
+    }
+  }
+
+  header << "};\n"
+            "\n"
+            "constexpr Production PRODUCTIONS[] = {\n";
+
+  std::size_t offset = 0;
+  for (const Grammar::Production &production : grammar.productions) {
+    header << "    {" << offset << ", " << production.right.size() << "},\n";
+    offset += production.right.size();
+  }
+
+  header << "};\n\n";
+}
+
+static void GenerateTable(const Grammar &grammar, std::ostream &header) {
+  header << "constexpr std::int16_t TABLE[NONTERMINALS][TERMINALS] = {\n";
+
+  for (std::size_t row = 0; row < grammar.nonterminals.size(); ++row) {
+    header << "    // " << grammar.nonterminals[row] << "\n    {";
+
+    for (std::size_t column = 0; column < grammar.terminals.size(); ++column) {
+      header << (column == 0 ? "" : column % 16 == 0 ? ",\n     " : ", ")
+             << grammar.table[row][column];
+    }
+
+    header << "},\n";
+  }
+
+  header << "};\n\n";
+}
+
+void GenerateHeader(const Grammar &grammar, const std::string &stem,
+                    std::ostream &header) {
+  if (grammar.terminals.size() > 0xff || grammar.nonterminals.size() > 0xff ||
+      grammar.actions.size() > 0xff) {
+    throw "Exception: Too many symbols in grammar";
+  }
+
+  std::size_t symbols = 0;
+  for (const Grammar::Production &production : grammar.productions) {
+    symbols += production.right.size();
+  }
+
+  if (symbols == 0 || symbols > 0xffff) {
+    throw "Exception: Unsupported size of grammar";
+  }
+
+  std::string name = Identifier(stem);
+
+  header << "// Generated by ll1, do not edit.\n"
+            "#pragma once\n"
+            "\n"
+            "#include <cstddef>\n"
+            "#include <cstdint>\n"
+            "\n"
+            "namespace "
+         << name << " {\n\n";
+
+  GenerateEnum("Terminal", grammar.terminals, header);
+  GenerateEnum("Nonterminal", grammar.nonterminals, header);
+  GenerateEnum("Action", grammar.actions, header);
+
+  header << "struct Symbol {\n"
+            "  enum Kind : std::uint8_t { TERMINAL, NONTERMINAL, ACTION } "
+            "kind;\n"
+            "  std::uint8_t id;\n"
+            "};\n"
+            "\n"
+            "// NOTE: right side of production is RIGHT_SIDES[offset] and "
+            "following\n"
+            "struct Production {\n"
+            "  std::uint16_t offset;\n"
+            "  std::uint16_t length;\n"
+            "};\n"
+            "\n"
+            "constexpr std::size_t TERMINALS = "
+         << grammar.terminals.size()
+         << ";\n"
+            "constexpr std::size_t NONTERMINALS = "
+         << grammar.nonterminals.size()
+         << ";\n"
+            "constexpr Nonterminal START = Nonterminal::"
+         << grammar.nonterminals.front()
+         << ";\n"
+            "constexpr std::int16_t NONE = "
+         << Grammar::NONE << ";\n\n";
+
+  GenerateProductions(grammar, header);
+  GenerateTable(grammar, header);
+  GenerateNames("TERMINAL_NAMES", grammar.terminals, header);
+  GenerateNames("NONTERMINAL_NAMES", grammar.nonterminals, header);
+
+  header << "} // namespace " << name << "\n";
+}
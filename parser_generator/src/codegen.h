@@ -0,0 +1,12 @@
+#pragma once
+
+#include "grammar.h"
+
+#include <ostream>
+#include <string>
+
+// NOTE: writes header with enums of grammar symbols and constexpr LL(1)
+// table in namespace <stem>; header is expected to be saved as <stem>.h and
+// is driven by LL1Parser from ll1.h
+void GenerateHeader(const Grammar &grammar, const std::string &stem,
+                    std::ostream &header);
@@ -0,0 +1,300 @@
+#include "grammar.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iterator>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+namespace {
+
+struct Rule {
+  std::string left;
+  std::vector<std::vector<std::string>> alternatives;
+};
+
+} // namespace
+
+static const std::string ARROW = "->";
+static const std::string EPS = "eps";
+
+// NOTE: C++ keywords and alternative tokens, none of them may name symbol
+static const char *const CPP_KEYWORDS[] = {
+    "alignas", "alignof", "and", "and_eq", "asm", "auto", "bitand", "bitor",
+    "bool", "break", "case", "catch", "char", "char8_t", "char16_t", "char32_t",
+    "class", "compl", "concept", "const", "consteval", "constexpr", "constinit",
+    "const_cast", "continue", "co_await", "co_return", "co_yield", "decltype",
+    "default", "delete", "do", "double", "dynamic_cast", "else", "enum",
+    "explicit", "export", "extern", "false", "float", "for", "friend", "goto",
+    "if", "inline", "int", "long", "mutable", "namespace", "new", "noexcept",
+    "not", "not_eq", "nullptr", "operator", "or", "or_eq", "private",
+    "protected", "public", "register", "reinterpret_cast", "requires", "return",
+    "short", "signed", "sizeof", "static", "static_assert", "static_cast",
+    "struct", "switch", "template", "this", "thread_local", "throw", "true",
+    "try", "typedef", "typeid", "typename", "union", "unsigned", "using",
+    "virtual", "void", "volatile", "wchar_t", "while", "xor", "xor_eq",
+};
+
+static std::vector<std::string> Split(std::istream &input) {
+  std::vector<std::string> words;
+  std::string line;
+
+  while (std::getline(input, line)) {
+    line = line.substr(0, line.find('#'));
+    std::istringstream stream(line);
+    for (std::string word; stream >> word;) {
+      words.push_back(std::move(word));
+    }
+  }
+
+  return words;
+}
+
+static std::vector<Rule> ParseRules(const std::vector<std::string> &words) {
+  std::vector<Rule> rules;
+
+  for (std::size_t i = 0; i < words.size(); ++i) {
+    if (i + 1 < words.size() && words[i + 1] == ARROW) {
+      if (words[i] == ARROW || words[i] == "|" || words[i][0] == '@') {
+        throw "Exception: Invalid name of rule";
+      }
+      rules.push_back({words[i], {{}}});
+      ++i;
+    } else if (rules.empty()) {
+      throw "Exception: Grammar must start with rule";
+    } else if (words[i] == "|") {
+      rules.back().alternatives.emplace_back();
+    } else if (words[i] == ARROW) {
+      throw "Exception: Rule without name";
+    } else {
+      rules.back().alternatives.back().push_back(words[i]);
+    }
+  }
+
+  if (rules.empty()) {
+    throw "Exception: Grammar is empty";
+  }
+
+  return rules;
+}
+
+bool Grammar::IsIdentifier(const std::string &name) {
+  auto is_word = [](char ch) {
+    return std::isalnum(static_cast<unsigned char>(ch)) || ch == '_';
+  };
+
+  return !name.empty() &&
+         !std::isdigit(static_cast<unsigned char>(name[0])) &&
+         std::all_of(name.begin(), name.end(), is_word) &&
+         std::find(std::begin(CPP_KEYWORDS), std::end(CPP_KEYWORDS), name) ==
+             std::end(CPP_KEYWORDS);
+}
+
+Grammar::Grammar(const std::filesystem::path &path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    throw "Exception: Can not open grammar file";
+  }
+  Load(file);
+}
+
+Grammar::Grammar(std::istream &input) { Load(input); }
+
+std::size_t Grammar::Intern(std::vector<std::string> &names,
+                            const std::string &name) {
+  auto it = std::find(names.begin(), names.end(), name);
+  if (it != names.end()) {
+    return it - names.begin();
+  }
+  names.push_back(name);
+  return names.size() - 1;
+}
+
+void Grammar::Load(std::istream &input) {
+  std::vector<Rule> rules = ParseRules(Split(input));
+
+  // NOTE: all names of rules are known before right sides are resolved, so
+  // rules may refer to the ones defined below
+  for (const Rule &rule : rules) {
+    if (rule.left == EPS || rule.left == END_OF_TEXT) {
+      throw "Exception: Reserved name of rule";
+    }
+    if (!IsIdentifier(rule.left)) {
+      throw "Exception: Name of rule must be C++ identifier, not keyword";
+    }
+    Intern(nonterminals, rule.left);
+  }
+
+  for (const Rule &rule : rules) {
+    std::size_t left = Intern(nonterminals, rule.left);
+
+    for (const auto &alternative : rule.alternatives) {
+      Production production{left, {}};
+
+      for (const std::string &word : alternative) {
+        if (word == EPS) {
+          continue;
+        }
+        if (word == END_OF_TEXT) {
+          throw "Exception: End marker is appended by generator";
+        }
+
+        if (word[0] == '@') {
+          if (word.size() == 1) {
+            throw "Exception: Action without name";
+          }
+          if (!IsIdentifier(word.substr(1))) {
+            throw "Exception: Name of action must be C++ identifier, not "
+                  "keyword";
+          }
+          production.right.push_back(
+              {Symbol::ACTION, Intern(actions, word.substr(1))});
+        } else if (std::find(nonterminals.begin(), nonterminals.end(),
+                             word) != nonterminals.end()) {
+          production.right.push_back(
+              {Symbol::NONTERMINAL, Intern(nonterminals, word)});
+        } else {
+          if (!IsIdentifier(word)) {
+            throw "Exception: Name of terminal must be C++ identifier, not "
+                  "keyword";
+          }
+          production.right.push_back(
+              {Symbol::TERMINAL, Intern(terminals, word)});
+        }
+      }
+
+      productions.push_back(std::move(production));
+    }
+  }
+
+  terminals.push_back(END_OF_TEXT);
+
+  ComputeNullable();
+  ComputeFirst();
+  ComputeFollow();
+  BuildTable();
+}
+
+void Grammar::ComputeNullable() {
+  nullable.assign(nonterminals.size(), false);
+
+  for (bool changed = true; changed;) {
+    changed = false;
+
+    for (const Production &production : productions) {
+      if (nullable[production.left]) {
+        continue;
+      }
+
+      bool all = std::all_of(
+          production.right.begin(), production.right.end(),
+          [this](const Symbol &symbol) {
+            return symbol.kind == Symbol::ACTION ||
+                   (symbol.kind == Symbol::NONTERMINAL && nullable[symbol.id]);
+          });
+
+      if (all) {
+        nullable[production.left] = changed = true;
+      }
+    }
+  }
+}
+
+std::set<std::size_t> Grammar::First(const std::vector<Symbol> &symbols,
+                                     std::size_t from,
+                                     bool &is_nullable) const {
+  std::set<std::size_t> result;
+  is_nullable = true;
+
+  for (std::size_t i = from; i < symbols.size() && is_nullable; ++i) {
+    const Symbol &symbol = symbols[i];
+
+    if (symbol.kind == Symbol::TERMINAL) {
+      result.insert(symbol.id);
+      is_nullable = false;
+    } else if (symbol.kind == Symbol::NONTERMINAL) {
+      result.insert(first[symbol.id].begin(), first[symbol.id].end());
+      is_nullable = nullable[symbol.id];
+    }
+  }
+
+  return result;
+}
+
+void Grammar::ComputeFirst() {
+  first.assign(nonterminals.size(), {});
+
+  for (bool changed = true; changed;) {
+    changed = false;
+
+    for (const Production &production : productions) {
+      bool is_nullable = false;
+      std::set<std::size_t> lookaheads =
+          First(production.right, 0, is_nullable);
+      std::size_t size = first[production.left].size();
+
+      first[production.left].insert(lookaheads.begin(), lookaheads.end());
+      changed = changed || first[production.left].size() != size;
+    }
+  }
+}
+
+void Grammar::ComputeFollow() {
+  follow.assign(nonterminals.size(), {});
+  follow[0].insert(terminals.size() - 1);
+
+  for (bool changed = true; changed;) {
+    changed = false;
+
+    for (const Production &production : productions) {
+      for (std::size_t i = 0; i < production.right.size(); ++i) {
+        const Symbol &symbol = production.right[i];
+        if (symbol.kind != Symbol::NONTERMINAL) {
+          continue;
+        }
+
+        bool is_nullable = false;
+        std::set<std::size_t> lookaheads =
+            First(production.right, i + 1, is_nullable);
+        if (is_nullable) {
+          lookaheads.insert(follow[production.left].begin(),
+                            follow[production.left].end());
+        }
+
+        std::size_t size = follow[symbol.id].size();
+        follow[symbol.id].insert(lookaheads.begin(), lookaheads.end());
+        changed = changed || follow[symbol.id].size() != size;
+      }
+    }
+  }
+}
+
+void Grammar::BuildTable() {
+  table.assign(nonterminals.size(),
+               std::vector<int>(terminals.size(), NONE));
+
+  for (std::size_t i = 0; i < productions.size(); ++i) {
+    const Production &production = productions[i];
+    bool is_nullable = false;
+    std::set<std::size_t> lookaheads = First(production.right, 0, is_nullable);
+
+    if (is_nullable) {
+      lookaheads.insert(follow[production.left].begin(),
+                        follow[production.left].end());
+    }
+
+    for (std::size_t terminal : lookaheads) {
+      int &cell = table[production.left][terminal];
+
+      if (cell != NONE && cell != static_cast<int>(i)) {
+        conflicts.push_back(nonterminals[production.left] + " on " +
+                            terminals[terminal] + ": productions " +
+                            std::to_string(cell) + " and " +
+                            std::to_string(i));
+        continue;
+      }
+      cell = static_cast<int>(i);
+    }
+  }
+}
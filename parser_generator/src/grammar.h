@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <istream>
+#include <set>
+#include <string>
+#include <vector>
+
+// NOTE: context-free grammar with semantic actions. Rules are written as
+// `Name -> symbols | symbols ...`, alternatives may continue on next lines.
+// Names defined by rules are nonterminals, names starting with '@' are
+// actions, the rest are terminals; `eps` stands for empty alternative and
+// '#' starts comment. The first rule defines start symbol. Every name must
+// be C++ identifier which is not keyword
+class Grammar {
+public:
+  struct Symbol {
+    enum Kind { TERMINAL, NONTERMINAL, ACTION } kind;
+    std::size_t id;
+  };
+
+  struct Production {
+    std::size_t left;
+    std::vector<Symbol> right;
+  };
+
+  static constexpr int NONE = -1;
+  // NOTE: end marker, always the last terminal
+  static constexpr const char *END_OF_TEXT = "END_OF_TEXT";
+
+  explicit Grammar(const std::filesystem::path &path);
+  explicit Grammar(std::istream &input);
+
+  // NOTE: names of symbols become enumerators of generated header, so they
+  // must be C++ identifiers and not keywords
+  static bool IsIdentifier(const std::string &name);
+
+  // NOTE: FIRST of symbols sequence, actions are transparent
+  std::set<std::size_t> First(const std::vector<Symbol> &symbols,
+                              std::size_t from, bool &is_nullable) const;
+
+private:
+  std::size_t Intern(std::vector<std::string> &names, const std::string &name);
+  void Load(std::istream &input);
+  void ComputeNullable();
+  void ComputeFirst();
+  void ComputeFollow();
+  void BuildTable();
+
+public:
+  std::vector<std::string> terminals;
+  std::vector<std::string> nonterminals;
+  std::vector<std::string> actions;
+  std::vector<Production> productions;
+
+  std::vector<bool> nullable;
+  std::vector<std::set<std::size_t>> first;
+  std::vector<std::set<std::size_t>> follow;
+  // NOTE: production to expand nonterminal by lookahead terminal or NONE
+  std::vector<std::vector<int>> table;
+  // NOTE: cells claimed by more than one production, grammar is LL(1) only
+  // if there are none
+  std::vector<std::string> conflicts;
+};
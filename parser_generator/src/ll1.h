@@ -0,0 +1,171 @@
+#pragma once
+
+#include "../../lexical_analyzer/src/tokens.h"
+// NOTE: generated from grammars/language.ll1 by target_ll1_grammar
+#include "language.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+// NOTE: token which does not fit grammar and symbol expected at it
+struct Mismatch {
+  TokenBuffer::Index token;
+  language::Symbol expected;
+};
+
+// NOTE: terminals acceptable instead of mismatched token, for nonterminal
+// these are the ones its row of table is filled for
+inline std::string Expected(language::Symbol symbol) {
+  if (symbol.kind == language::Symbol::TERMINAL) {
+    return language::TERMINAL_NAMES[symbol.id];
+  }
+
+  std::string names;
+  for (std::size_t terminal = 0; terminal < language::TERMINALS; ++terminal) {
+    if (language::TABLE[symbol.id][terminal] != language::NONE) {
+      names += names.empty() ? "" : " or ";
+      names += language::TERMINAL_NAMES[terminal];
+    }
+  }
+  return names;
+}
+
+// NOTE: terminal standing for token, END_OF_TEXT past the last token and
+// nothing for erroneous ones
+inline std::optional<language::Terminal> TerminalOf(const TokenBuffer &tokens,
+                                                    TokenBuffer::Index index) {
+  using language::Terminal;
+
+  if (index >= tokens.Size()) {
+    return Terminal::END_OF_TEXT;
+  }
+
+  switch (tokens.Category(index)) {
+  case Lexeme::Category::IDENTIFIER:
+    return Terminal::IDENTIFIER;
+  case Lexeme::Category::CONSTANT:
+    return Terminal::CONSTANT;
+  case Lexeme::Category::INVALID:
+    return std::nullopt;
+  default:
+    break;
+  }
+
+  switch (tokens.Type(index)) {
+  case Lexeme::Type::IF:
+    return Terminal::IF;
+  case Lexeme::Type::THEN:
+    return Terminal::THEN;
+  case Lexeme::Type::END:
+    return Terminal::END;
+  case Lexeme::Type::ELSEIF:
+    return Terminal::ELSEIF;
+  case Lexeme::Type::ELSE:
+    return Terminal::ELSE;
+  case Lexeme::Type::AND:
+    return Terminal::AND;
+  case Lexeme::Type::OR:
+    return Terminal::OR;
+  case Lexeme::Type::RELATION:
+    return Terminal::RELATION;
+  case Lexeme::Type::ARITHMETIC_SIMPLE:
+    return Terminal::ARITHMETIC_SIMPLE;
+  case Lexeme::Type::ARITHMETIC_DIFICULT:
+    return Terminal::ARITHMETIC_DIFICULT;
+  case Lexeme::Type::ASSIGNMENT:
+    return Terminal::ASSIGNMENT;
+  case Lexeme::Type::INPUT:
+    return Terminal::INPUT;
+  case Lexeme::Type::OUTPUT:
+    return Terminal::OUTPUT;
+  case Lexeme::Type::BRACKET:
+    return tokens.Value(index) == "(" ? Terminal::OPENING_PARENTHESIS
+                                      : Terminal::CLOSING_PARENTHESIS;
+  case Lexeme::Type::SEPARATOR:
+    return Terminal::SEPARATOR;
+  case Lexeme::Type::UNDEFINED:
+  case Lexeme::Type::ERROR:
+    break;
+  }
+
+  return std::nullopt;
+}
+
+// NOTE: predictive parser driven by generated LL(1) table. Symbols to match
+// wait on explicit stack instead of call stack, so nesting and length of
+// chains are limited by memory only. Action is called when every symbol
+// before it in production is matched, with index of the first token of the
+// production. Stack is kept between calls, so in steady state parsing does
+// not allocate. There is no error recovery, parsing stops at the first
+// mismatch
+class LL1Parser {
+public:
+  template <typename Actions>
+  auto Parse(const TokenBuffer &tokens, Actions &&actions)
+      -> std::optional<Mismatch>;
+
+private:
+  struct Frame {
+    language::Symbol symbol;
+    TokenBuffer::Index begin;
+  };
+
+  std::vector<Frame> stack;
+};
+
+template <typename Actions>
+auto LL1Parser::Parse(const TokenBuffer &tokens, Actions &&actions)
+    -> std::optional<Mismatch> {
+  using language::Symbol;
+  using language::Terminal;
+
+  stack.clear();
+  stack.push_back(
+      {{Symbol::NONTERMINAL, static_cast<std::uint8_t>(language::START)}, 0});
+
+  TokenBuffer::Index at = 0;
+  std::optional<Terminal> lookahead = TerminalOf(tokens, at);
+
+  while (!stack.empty()) {
+    Frame frame = stack.back();
+    stack.pop_back();
+
+    switch (frame.symbol.kind) {
+    case Symbol::TERMINAL:
+      if (lookahead != static_cast<Terminal>(frame.symbol.id)) {
+        return Mismatch{at, frame.symbol};
+      }
+      lookahead = TerminalOf(tokens, ++at);
+      break;
+    case Symbol::ACTION:
+      actions(static_cast<language::Action>(frame.symbol.id), frame.begin);
+      break;
+    case Symbol::NONTERMINAL: {
+      std::int16_t production =
+          lookahead ? language::TABLE[frame.symbol.id]
+                                     [static_cast<std::size_t>(*lookahead)]
+                    : language::NONE;
+      if (production == language::NONE) {
+        return Mismatch{at, frame.symbol};
+      }
+
+      const language::Production &rule = language::PRODUCTIONS[production];
+      for (std::size_t i = rule.length; i-- > 0;) {
+        stack.push_back({language::RIGHT_SIDES[rule.offset + i], at});
+      }
+      break;
+    }
+    }
+  }
+
+  if (lookahead != Terminal::END_OF_TEXT) {
+    return Mismatch{at,
+                    {Symbol::TERMINAL,
+                     static_cast<std::uint8_t>(Terminal::END_OF_TEXT)}};
+  }
+
+  return std::nullopt;
+}
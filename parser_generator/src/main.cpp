@@ -0,0 +1,62 @@
+#include "codegen.h"
+#include "grammar.h"
+#include "out.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+void PrintHelp() {
+  std::cout << "Usage:\n"
+               "\tll1 <path/to/grammar> <path/to/name>\n"
+               "\tll1 --print <path/to/grammar>\n\n"
+               "OPTIONS\n"
+               "\t<path/to/grammar> <path/to/name>\t\tgenerate <name>.h with "
+               "LL(1) table of grammar\n"
+               "\t--print <path/to/grammar>\t\t\tshow productions, FIRST and "
+               "FOLLOW sets and LL(1) table of grammar\n";
+}
+
+int main(int argc, char **argv) {
+  if (argc != 3) {
+    PrintHelp();
+    return 1;
+  }
+
+  std::string first = argv[1];
+  bool print = first == "--print";
+
+  try {
+    Grammar grammar(std::filesystem::path(print ? argv[2] : argv[1]));
+
+    if (print) {
+      std::cout << Render(grammar);
+      return grammar.conflicts.empty() ? 0 : 1;
+    }
+
+    if (!grammar.conflicts.empty()) {
+      std::cerr << "ll1 : Error: grammar is not LL(1)!\n";
+      for (const std::string &conflict : grammar.conflicts) {
+        std::cerr << "\t" << conflict << '\n';
+      }
+      return 1;
+    }
+
+    // NOTE: header is generated in memory first, so failed generation does
+    // not truncate the previous one
+    std::filesystem::path output = argv[2];
+    std::ostringstream header;
+    GenerateHeader(grammar, output.filename().string(), header);
+
+    std::ofstream file(output.string() + ".h");
+    if (!file.is_open()) {
+      std::cerr << "ll1 : Error: can not open output file!\n";
+      return 1;
+    }
+    file << header.str();
+  } catch (const char *exception) {
+    std::cerr << "ll1 : Error: " << exception << '\n';
+    return 1;
+  }
+}
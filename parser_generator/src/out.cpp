@@ -0,0 +1,75 @@
+#include "out.h"
+
+static void AppendSet(std::string &buffer, const Grammar &grammar,
+                      const std::set<std::size_t> &terminals) {
+  for (std::size_t terminal : terminals) {
+    buffer += ' ';
+    buffer += grammar.terminals[terminal];
+  }
+}
+
+static void AppendProduction(std::string &buffer, const Grammar &grammar,
+                             std::size_t index) {
+  const Grammar::Production &production = grammar.productions[index];
+
+  buffer += std::to_string(index) + ": ";
+  buffer += grammar.nonterminals[production.left] + " ->";
+
+  for (const Grammar::Symbol &symbol : production.right) {
+    buffer += ' ';
+    if (symbol.kind == Grammar::Symbol::ACTION) {
+      buffer += '@' + grammar.actions[symbol.id];
+    } else if (symbol.kind == Grammar::Symbol::NONTERMINAL) {
+      buffer += grammar.nonterminals[symbol.id];
+    } else {
+      buffer += grammar.terminals[symbol.id];
+    }
+  }
+
+  buffer += production.right.empty() ? " eps\n" : "\n";
+}
+
+std::string Render(const Grammar &grammar) {
+  std::string buffer = "productions:\n";
+
+  for (std::size_t i = 0; i < grammar.productions.size(); ++i) {
+    buffer += "  ";
+    AppendProduction(buffer, grammar, i);
+  }
+
+  buffer += "\nfirst:\n";
+  for (std::size_t i = 0; i < grammar.nonterminals.size(); ++i) {
+    buffer += "  " + grammar.nonterminals[i] + ':';
+    AppendSet(buffer, grammar, grammar.first[i]);
+    buffer += grammar.nullable[i] ? " eps\n" : "\n";
+  }
+
+  buffer += "\nfollow:\n";
+  for (std::size_t i = 0; i < grammar.nonterminals.size(); ++i) {
+    buffer += "  " + grammar.nonterminals[i] + ':';
+    AppendSet(buffer, grammar, grammar.follow[i]);
+    buffer += '\n';
+  }
+
+  buffer += "\ntable:\n";
+  for (std::size_t row = 0; row < grammar.nonterminals.size(); ++row) {
+    for (std::size_t column = 0; column < grammar.terminals.size(); ++column) {
+      int production = grammar.table[row][column];
+      if (production == Grammar::NONE) {
+        continue;
+      }
+      buffer += "  " + grammar.nonterminals[row] + ", " +
+                grammar.terminals[column] + " => " +
+                std::to_string(production) + '\n';
+    }
+  }
+
+  if (!grammar.conflicts.empty()) {
+    buffer += "\nconflicts:\n";
+    for (const std::string &conflict : grammar.conflicts) {
+      buffer += "  " + conflict + '\n';
+    }
+  }
+
+  return buffer;
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "grammar.h"
+
+#include <string>
+
+// NOTE: productions, FIRST and FOLLOW sets of nonterminals and filled cells
+// of LL(1) table in plain text, conflicts are listed last
+std::string Render(const Grammar &grammar);
@@ -0,0 +1,26 @@
+#include "../../syntactic_parser/bench/measure.h"
+#include "../src/parser.h"
+#include "../src/tableparser.h"
+
+// NOTE: lexing, parsing and generation of entries are measured together;
+// parsers and buffers are reused between runs, so steady state is measured
+static void MeasureParsers(const std::string &name, const std::string &text) {
+  SyntacticParser parser;
+  TableParser table_parser;
+  std::vector<Entry> entries;
+  std::vector<Diagnostic> diagnostics;
+
+  Measure(name + " Parse", text, [&] {
+    return parser.Parse(text, entries, diagnostics) ? parser.tokens.Size()
+                                                    : 0;
+  });
+  Measure(name + " TableParser", text, [&] {
+    return table_parser.Parse(text, entries, diagnostics)
+               ? table_parser.tokens.Size()
+               : 0;
+  });
+}
+
+int main(int argc, char **argv) {
+  return RunBenchmark(argc, argv, MeasureParsers);
+}
@@ -0,0 +1,34 @@
+# NOTE: builds parser with code generation and its LL(1) front end once as
+# library semantic_analyzer_core on top of lexer_core
+
+include(${CMAKE_CURRENT_LIST_DIR}/../lexical_analyzer/lexer.cmake)
+include(${CMAKE_CURRENT_LIST_DIR}/../parser_generator/ll1.cmake)
+
+set(SEMANTIC_ANALYZER_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+set(SEMANTIC_ANALYZER_SRC
+  ${SEMANTIC_ANALYZER_DIR}/src/parser.cpp
+  ${SEMANTIC_ANALYZER_DIR}/src/tableparser.cpp
+  ${SEMANTIC_ANALYZER_DIR}/src/symbols.cpp
+  ${SEMANTIC_ANALYZER_DIR}/src/pool.cpp
+)
+
+set(SEMANTIC_ANALYZER_HEADER
+  ${SEMANTIC_ANALYZER_DIR}/src/parser.h
+  ${SEMANTIC_ANALYZER_DIR}/src/tableparser.h
+
+  ${SEMANTIC_ANALYZER_DIR}/src/entry.h
+  ${SEMANTIC_ANALYZER_DIR}/src/symbols.h
+  ${SEMANTIC_ANALYZER_DIR}/src/pool.h
+)
+
+if(NOT TARGET semantic_analyzer_core)
+  add_library(semantic_analyzer_core ${SEMANTIC_ANALYZER_SRC}
+    ${SEMANTIC_ANALYZER_HEADER})
+
+  target_compile_options(semantic_analyzer_core PRIVATE
+    $<$<NOT:$<CONFIG:Debug>>:-O2>)
+  target_link_libraries(semantic_analyzer_core PUBLIC lexer_core)
+
+  target_ll1_grammar(semantic_analyzer_core ${LL1_DIR}/grammars/language.ll1)
+endif()
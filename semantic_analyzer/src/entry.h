@@ -1,8 +1,11 @@
 #pragma once
 
+#include "symbols.h"
+
+#include <climits>
 #include <cstdint>
-#include <string>
 #include <variant>
+#include <vector>
 
 struct Entry {
   enum Command {
@@ -24,5 +27,81 @@ struct Entry {
     BRACKET,
   };
   enum EntryType { COMMAND, VARIABLE, CONSTANT, INSTRUCTION_POINTER } type;
-  std::variant<Command, std::string, int> data;
+  std::variant<Command, Symbol, int> data;
 };
+
+// NOTE: unresolved jumps of construct form backpatch chain, operand of each
+// holds index of the previous one and the first holds -1, so every jump is
+// patched exactly once when construct is finished
+inline void JumpToEnd(std::vector<Entry> &entries, int &chain) {
+  int operand = static_cast<int>(entries.size());
+  entries.emplace_back(Entry::EntryType::INSTRUCTION_POINTER, chain);
+  entries.emplace_back(Entry::EntryType::COMMAND, Entry::Command::JMP);
+  chain = operand;
+}
+
+inline void Backpatch(std::vector<Entry> &entries, int chain, int target) {
+  while (chain != -1) {
+    int previous = std::get<int>(entries[chain].data);
+    entries[chain].data = target;
+    chain = previous;
+  }
+}
+
+// NOTE: constant result of operation as interpreter computes it; division
+// by zero and overflow are left to run time
+inline bool Fold(Entry::Command command, int left, int right, int &result) {
+  switch (command) {
+  case Entry::Command::ADD:
+    return !__builtin_add_overflow(left, right, &result);
+  case Entry::Command::SUB:
+    return !__builtin_sub_overflow(left, right, &result);
+  case Entry::Command::MUL:
+    return !__builtin_mul_overflow(left, right, &result);
+  case Entry::Command::DIV:
+    if (right == 0 || (left == INT_MIN && right == -1)) {
+      return false;
+    }
+    result = left / right;
+    return true;
+  case Entry::Command::CMPE:
+    result = left == right;
+    return true;
+  case Entry::Command::CMPNE:
+    result = left != right;
+    return true;
+  case Entry::Command::CMPL:
+    result = left < right;
+    return true;
+  case Entry::Command::CMPG:
+    result = left > right;
+    return true;
+  case Entry::Command::AND:
+    result = left && right;
+    return true;
+  case Entry::Command::OR:
+    result = left || right;
+    return true;
+  default:
+    return false;
+  }
+}
+
+// NOTE: emits binary operation folding constant operands into its result.
+// In postfix form compound operand ends with command, so operand ending with
+// constant is that constant alone
+inline void EmitOperation(std::vector<Entry> &entries, Entry::Command command) {
+  std::size_t size = entries.size();
+  int result = 0;
+
+  if (size >= 2 && entries[size - 2].type == Entry::EntryType::CONSTANT &&
+      entries[size - 1].type == Entry::EntryType::CONSTANT &&
+      Fold(command, std::get<int>(entries[size - 2].data),
+           std::get<int>(entries[size - 1].data), result)) {
+    entries.pop_back();
+    entries.back().data = result;
+    return;
+  }
+
+  entries.emplace_back(Entry::EntryType::COMMAND, command);
+}
@@ -1,16 +1,9 @@
 #include "parser.h"
+#include "tableparser.h"
 #include <iostream>
 
-int main(int argc, char **argv) {
-  SyntacticParser parser;
-  const auto &[record, success] = parser.Parse(argv[1]);
-
-  if (!success) {
-    std::cout << "NOT OK\n";
-    return 1;
-  }
-
-  for (auto entry : record) {
+void Print(const std::vector<Entry> &entries, const SymbolTable &symbols) {
+  for (auto entry : entries) {
     if (entry.type == Entry::EntryType::COMMAND) {
       Entry::Command command = std::get<Entry::Command>(entry.data);
       std::string cmd;
@@ -66,7 +59,7 @@ int main(int argc, char **argv) {
       }
       std::cout << cmd << " ";
     } else if (entry.type == Entry::EntryType::VARIABLE) {
-      std::cout << std::get<std::string>(entry.data) << " ";
+      std::cout << symbols.Name(std::get<Symbol>(entry.data)) << " ";
     } else if (entry.type == Entry::EntryType::CONSTANT ||
                entry.type == Entry::EntryType::INSTRUCTION_POINTER) {
       std::cout << std::get<int>(entry.data) << " ";
@@ -74,3 +67,25 @@ int main(int argc, char **argv) {
   }
   std::cout << std::endl;
 }
+
+int main(int argc, char **argv) {
+  SyntacticParser parser;
+  TableParser table_parser;
+
+  // NOTE: `--ll1 <program>` translates program by generated LL(1) table
+  bool ll1 = argc > 2 && std::string(argv[1]) == "--ll1";
+  ParseResult result =
+      ll1 ? table_parser.Parse(argv[2]) : parser.Parse(argv[1]);
+
+  for (const Diagnostic &diagnostic : result.diagnostics) {
+    std::cerr << diagnostic.line << ":" << diagnostic.column << ": "
+              << diagnostic.message << std::endl;
+  }
+
+  if (!result.success) {
+    std::cout << "NOT OK\n";
+    return 1;
+  }
+
+  Print(result.entries, ll1 ? table_parser.symbols : parser.symbols);
+}
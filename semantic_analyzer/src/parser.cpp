@@ -1,208 +1,228 @@
 #include "parser.h"
-#include <iostream>
+#include <algorithm>
+#include <charconv>
 
-using Iterator = std::vector<Lexeme>::iterator;
+using Iterator = SyntacticParser::Iterator;
+using Result = SyntacticParser::Result;
 
-static void error(Iterator iter, const Iterator end,
-                  const std::string &reason) {
-  std::cerr << "syntax error: " << reason << '\n';
-  for (auto item = iter; item != end; ++item) {
-    std::cerr << item->value << ' ';
+void SyntacticParser::Report(Iterator at, const char *reason) {
+  // NOTE: erroneous lexemes are already reported by lexer
+  if (tokens.Type(at) == Lexeme::Type::ERROR) {
+    return;
   }
-  std::cerr << "\033[1;31m" << end->value << "\033[0m\n";
+
+  bool is_token = at < tokens.Size();
+  Diagnostic diagnostic =
+      Locate(source, is_token ? tokens.Offset(at) : source.size());
+  diagnostic.message =
+      std::string("syntax error: ") + reason +
+      (is_token ? " near '" + std::string(tokens.Value(at)) + "'"
+                : std::string(" at the end of text"));
+  diagnostics.push_back(std::move(diagnostic));
+}
+
+// NOTE: panic mode, tokens are skipped up to the nearest ';', 'end',
+// 'elseif' or 'else', and the caller goes on as if its construction ended
+// right before it. Errors on that token are consequences of the skipped ones,
+// so they are not reported
+Iterator SyntacticParser::Recover(Iterator at, Iterator end,
+                                  const char *reason) {
+  at = std::min(at, end);
+  if (at != synchronized) {
+    Report(at, reason);
+  }
+
+  Iterator sync = at;
+  while (sync < end && !Synchronizing(sync)) {
+    ++sync;
+  }
+
+  synchronized = sync;
+  return sync - 1;
 }
 
-std::tuple<Iterator, bool> SyntacticParser::IfStatement(Iterator begin,
-                                                        Iterator end) {
+Result SyntacticParser::IfStatement(Iterator begin, Iterator end) {
   if (!If(begin)) {
     return {begin, false};
   }
 
   const auto &[endOfLogExpr, success1] = LogExpr(begin + 1, end);
+  Iterator endOfCondition = endOfLogExpr + 1;
   if (!success1) {
-    error(begin, endOfLogExpr + 1,
-          "expected logical expression as condition in 'if' statement");
-    exit(1);
-  }
-
-  if (!Then(endOfLogExpr + 1)) {
-    error(begin, endOfLogExpr + 1,
-          "expected keyword 'then' after condition of 'if' statement");
-    exit(1);
+    endOfCondition = Recover(
+        endOfLogExpr, end,
+        "expected logical expression as condition in 'if' statement");
+  } else if (!Then(endOfLogExpr + 1)) {
+    endOfCondition =
+        Recover(endOfLogExpr + 1, end,
+                "expected keyword 'then' after condition of 'if' statement");
   }
 
   size_t indexOfJzOp2 = entries.size();
   entries.emplace_back(Entry::EntryType::INSTRUCTION_POINTER, -1);
   entries.emplace_back(Entry::EntryType::COMMAND, Entry::Command::JZ);
 
-  const auto &[endOfStatement, success2] = Statement(endOfLogExpr + 2, end);
+  const auto &[endOfStatement, success2] = Statement(endOfCondition + 1, end);
+  Iterator endOfBody = endOfStatement;
   if (!success2) {
-    error(begin, endOfStatement, "expected statement in 'if' body");
-    exit(1);
+    endOfBody = Recover(endOfStatement, end, "expected statement in 'if' body");
   }
 
-  entries.emplace_back(Entry::EntryType::INSTRUCTION_POINTER, -1);
-  entries.emplace_back(Entry::EntryType::COMMAND, Entry::Command::JMP);
+  int exits = -1;
+  JumpToEnd(entries, exits);
   entries[indexOfJzOp2].data = static_cast<int>(entries.size());
 
   const auto &[endOfOptionalAlterIfStatement, success3] =
-      AlterIfStatement(endOfStatement + 1, end);
+      AlterIfStatement(endOfBody + 1, end, exits);
+  Backpatch(entries, exits, static_cast<int>(entries.size()));
 
   if (!End(endOfOptionalAlterIfStatement + 1)) {
-    error(begin, endOfOptionalAlterIfStatement + 1,
-          "expected keyword 'end' after 'if' body");
-    exit(1);
-  }
-
-  for (Entry &entry : entries) {
-    if (entry.type == Entry::EntryType::INSTRUCTION_POINTER &&
-        std::get<int>(entry.data) == -1) {
-      entry.data = static_cast<int>(entries.size());
-    }
+    return {Recover(endOfOptionalAlterIfStatement + 1, end,
+                    "expected keyword 'end' after 'if' body"),
+            true};
   }
-
   return {endOfOptionalAlterIfStatement + 1, true};
 }
 
-std::tuple<Iterator, bool> SyntacticParser::AlterIfStatement(Iterator begin,
-                                                             Iterator end) {
-  if (ElseIf(begin)) {
-    const auto &[endOfLogExpr, success1] = LogExpr(begin + 1, end);
+// NOTE: on failure returns token before `begin`, which is the last one of
+// preceding construction. Chain of 'elseif' is parsed in a loop
+Result SyntacticParser::AlterIfStatement(Iterator begin, Iterator end,
+                                         int &exits) {
+  Iterator at = begin;
+
+  while (ElseIf(at)) {
+    const auto &[endOfLogExpr, success1] = LogExpr(at + 1, end);
+    Iterator endOfCondition = endOfLogExpr + 1;
     if (!success1) {
-      error(begin + 1, endOfLogExpr,
-            "expected logical expression as condition in 'elseif' statement");
-      exit(1);
-    }
-    if (!Then(endOfLogExpr + 1)) {
-      error(begin, endOfLogExpr + 1,
-            "expected keyword 'then' after condition of 'elseif' statement");
-      exit(1);
+      endOfCondition = Recover(
+          endOfLogExpr, end,
+          "expected logical expression as condition in 'elseif' statement");
+    } else if (!Then(endOfLogExpr + 1)) {
+      endOfCondition = Recover(
+          endOfLogExpr + 1, end,
+          "expected keyword 'then' after condition of 'elseif' statement");
     }
 
     size_t indexOfJzOp2 = entries.size();
     entries.emplace_back(Entry::EntryType::INSTRUCTION_POINTER, -1);
     entries.emplace_back(Entry::EntryType::COMMAND, Entry::Command::JZ);
 
-    const auto &[endOfStatement, success2] = Statement(endOfLogExpr + 2, end);
+    const auto &[endOfStatement, success2] =
+        Statement(endOfCondition + 1, end);
+    Iterator endOfBody = endOfStatement;
     if (!success2) {
-      error(begin, endOfStatement, "expected statement in 'if' body");
-      exit(1);
+      endOfBody =
+          Recover(endOfStatement, end, "expected statement in 'if' body");
     }
 
-    entries.emplace_back(Entry::EntryType::INSTRUCTION_POINTER, -1);
-    entries.emplace_back(Entry::EntryType::COMMAND, Entry::Command::JMP);
+    JumpToEnd(entries, exits);
     entries[indexOfJzOp2].data = static_cast<int>(entries.size());
-
-    const auto &[endOfAlterIfStatement, success3] =
-        AlterIfStatement(endOfStatement + 1, end);
-    return {endOfAlterIfStatement, true};
-  } else if (Else(begin)) {
-    const auto &[endOfStatement, success] = Statement(begin + 1, end);
-    if (!success) {
-      error(begin + 1, endOfStatement, "expected statement in 'else' body");
-      exit(1);
-    }
-    return {endOfStatement, true};
+    at = endOfBody + 1;
   }
 
-  return {begin, false};
-}
+  if (!Else(at)) {
+    return {at - 1, at != begin};
+  }
 
-std::tuple<Iterator, bool> SyntacticParser::LogExpr(Iterator begin,
-                                                    Iterator end) {
-  const auto &[endOfLogExprInner, success] = LogExprInner(begin, end);
+  const auto &[endOfStatement, success] = Statement(at + 1, end);
   if (!success) {
-    return {begin, false};
+    return {Recover(endOfStatement, end, "expected statement in 'else' body"),
+            true};
   }
-
-  const auto &[endOfLogExprTail, success2] =
-      LogExprTail(endOfLogExprInner + 1, end);
-  return {success2 ? endOfLogExprTail : endOfLogExprInner, true};
+  return {endOfStatement, true};
 }
 
-std::tuple<Iterator, bool> SyntacticParser::LogExprTail(Iterator begin,
-                                                        Iterator end) {
-  if (!LogOp1(begin)) {
-    return {begin, false};
-  }
-
-  const auto &[endOfLogExprInner, success] = LogExprInner(begin + 1, end);
+// NOTE: precedence climbing, operators of one precedence are parsed in a
+// loop and the ones binding tighter by recursive call, so depth of calls is
+// bounded by the number of precedences. Operations are left associative
+Result SyntacticParser::Expression(Iterator begin, Iterator end,
+                                   Expr expression, int precedence) {
+  const auto &[endOfPrimary, success] =
+      expression == Expr::LOGICAL ? RelExpr(begin, end) : ArithUnit(begin, end);
   if (!success) {
-    error(begin, endOfLogExprInner,
-          "expected relation expression in logical expression");
-    exit(1);
+    return {begin, false};
   }
 
-  entries.emplace_back(Entry::EntryType::COMMAND, Entry::Command::OR);
-
-  const auto &[endOfLogExprTail, success2] =
-      LogExprTail(endOfLogExprInner + 1, end);
-  return {success2 ? endOfLogExprTail : endOfLogExprInner, true};
-}
+  Iterator last = endOfPrimary;
+  for (int current = Precedence(last + 1, expression); current >= precedence;
+       current = Precedence(last + 1, expression)) {
+    Iterator op = last + 1;
+    const auto &[endOfOperand, success] =
+        Expression(op + 1, end, expression, current + 1);
+    if (!success) {
+      const char *reason =
+          expression == Expr::LOGICAL
+              ? "expected relation expression in logical expression"
+              : "expected operand in arithmetic expression";
+      return {Recover(endOfOperand, end, reason), true};
+    }
 
-std::tuple<Iterator, bool> SyntacticParser::LogExprInner(Iterator begin,
-                                                         Iterator end) {
-  const auto &[endOfRelExpr, success1] = RelExpr(begin, end);
-  if (!success1) {
-    return {begin, false};
+    EmitOperation(entries, Operation(op));
+    last = endOfOperand;
   }
 
-  const auto &[endOfLogExprInnerTail, success2] =
-      LogExprInnerTail(endOfRelExpr + 1, end);
-  return {success2 ? endOfLogExprInnerTail : endOfRelExpr, true};
+  return {last, true};
 }
 
-std::tuple<Iterator, bool> SyntacticParser::LogExprInnerTail(Iterator begin,
-                                                             Iterator end) {
-  if (!LogOp2(begin)) {
-    return {begin, false};
-  }
+int SyntacticParser::Precedence(Iterator at, Expr expression) {
+  Lexeme::Type type = tokens.Type(at);
 
-  const auto &[endOfRelExpr, success] = RelExpr(begin + 1, end);
-  if (!success) {
-    error(begin, endOfRelExpr,
-          "expected relation expression in logical expression");
-    exit(1);
+  if (expression == Expr::LOGICAL) {
+    return type == Lexeme::Type::OR ? 1 : type == Lexeme::Type::AND ? 2 : 0;
+  }
+  return type == Lexeme::Type::ARITHMETIC_SIMPLE     ? 1
+         : type == Lexeme::Type::ARITHMETIC_DIFICULT ? 2
+                                                     : 0;
+}
+
+Entry::Command SyntacticParser::Operation(Iterator op) {
+  std::string_view value = tokens.Value(op);
+
+  switch (tokens.Type(op)) {
+  case Lexeme::Type::OR:
+    return Entry::Command::OR;
+  case Lexeme::Type::AND:
+    return Entry::Command::AND;
+  case Lexeme::Type::ARITHMETIC_SIMPLE:
+    return value == "+" ? Entry::Command::ADD : Entry::Command::SUB;
+  case Lexeme::Type::ARITHMETIC_DIFICULT:
+    return value == "*" ? Entry::Command::MUL : Entry::Command::DIV;
+  default:
+    break;
   }
 
-  entries.emplace_back(Entry::EntryType::COMMAND, Entry::Command::AND);
+  return value == ">"   ? Entry::Command::CMPG
+         : value == "<"  ? Entry::Command::CMPL
+         : value == "==" ? Entry::Command::CMPE
+                         : Entry::Command::CMPNE;
+}
 
-  const auto &[endOfLogExprInnerTail, success2] =
-      LogExprInnerTail(endOfRelExpr + 1, end);
-  return {success2 ? endOfLogExprInnerTail : endOfRelExpr, true};
+Result SyntacticParser::LogExpr(Iterator begin, Iterator end) {
+  return Expression(begin, end, Expr::LOGICAL, 1);
 }
 
-std::tuple<Iterator, bool> SyntacticParser::RelExpr(Iterator begin,
-                                                    Iterator end) {
+Result SyntacticParser::RelExpr(Iterator begin, Iterator end) {
   if (!Operand(begin)) {
     return {begin, false};
   }
 
   if (RelOp(begin + 1)) {
     if (!Operand(begin + 2)) {
-      error(begin, begin + 2, "expected operand in relation expression");
-      exit(1);
-    }
-    if ((begin + 1)->value == ">") {
-      entries.emplace_back(Entry::EntryType::COMMAND, Entry::Command::CMPG);
-    } else if ((begin + 1)->value == "<") {
-      entries.emplace_back(Entry::EntryType::COMMAND, Entry::Command::CMPL);
-    } else if ((begin + 1)->value == "==") {
-      entries.emplace_back(Entry::EntryType::COMMAND, Entry::Command::CMPE);
-    } else if ((begin + 1)->value == "<>") {
-      entries.emplace_back(Entry::EntryType::COMMAND, Entry::Command::CMPNE);
+      return {Recover(begin + 2, end,
+                      "expected operand in relation expression"),
+              true};
     }
+    EmitOperation(entries, Operation(begin + 1));
     return {begin + 2, true};
   }
   return {begin, true};
 }
 
 bool SyntacticParser::RelOp(Iterator begin) {
-  return begin->type == Lexeme::Type::RELATION;
+  return tokens.Type(begin) == Lexeme::Type::RELATION;
 }
 
-std::tuple<Iterator, bool> SyntacticParser::Statement(Iterator begin,
-                                                      Iterator end) {
+Result SyntacticParser::Statement(Iterator begin, Iterator end) {
   const auto &[endOfInstruction, success] = Instruction(begin, end);
   if (!success) {
     return {begin, false};
@@ -213,38 +233,41 @@ std::tuple<Iterator, bool> SyntacticParser::Statement(Iterator begin,
     const auto &[endOfInstruction, success] =
         Instruction(endOfLastInstruction + 2, end);
     if (!success) {
-      error(begin, endOfInstruction, "expected intruction after semicolon");
-      exit(1);
+      endOfLastInstruction = Recover(endOfInstruction, end,
+                                     "expected instruction after semicolon");
+      continue;
     }
     endOfLastInstruction = endOfInstruction;
   }
   return {endOfLastInstruction, true};
 }
 
-std::tuple<Iterator, bool> SyntacticParser::Instruction(Iterator begin,
-                                                        Iterator end) {
+Result SyntacticParser::Instruction(Iterator begin, Iterator end) {
   if (Identifier(begin)) {
     if (AssignmentOp(begin + 1)) {
       const auto &[endOfArithExpr, success] = ArithExpr(begin + 2, end);
       if (!success) {
-        error(begin, endOfArithExpr,
-              "expected arithmetic expression after assignment operator");
-        exit(1);
+        Iterator endOfError = Recover(
+            endOfArithExpr, end,
+            "expected arithmetic expression after assignment operator");
+        return {endOfError, true};
       }
       entries.emplace_back(Entry::EntryType::COMMAND, Entry::Command::MOV);
       return {endOfArithExpr, true};
     }
   } else if (InputOp(begin)) {
     if (!Identifier(begin + 1)) {
-      error(begin, begin + 1, "expected identifier after input keyword");
-      exit(1);
+      return {Recover(begin + 1, end,
+                      "expected identifier after input keyword"),
+              true};
     }
     entries.emplace_back(Entry::EntryType::COMMAND, Entry::Command::INPUT);
     return {begin + 1, true};
   } else if (OutputOp(begin)) {
     if (!Operand(begin + 1)) {
-      error(begin, begin + 1, "expected operand after output keyword");
-      exit(1);
+      return {Recover(begin + 1, end,
+                      "expected operand after output keyword"),
+              true};
     }
     entries.emplace_back(Entry::EntryType::COMMAND, Entry::Command::OUTPUT);
     return {begin + 1, true};
@@ -253,75 +276,11 @@ std::tuple<Iterator, bool> SyntacticParser::Instruction(Iterator begin,
   return {begin, false};
 }
 
-std::tuple<Iterator, bool> SyntacticParser::ArithExpr(Iterator begin,
-                                                      Iterator end) {
-  const auto &[endOfArithExprInner, success] = ArithExprInner(begin, end);
-  if (!success) {
-    return {begin, false};
-  }
-
-  const auto &[endOfArithExprTail, success2] =
-      ArithExprTail(endOfArithExprInner + 1, end);
-  return {success2 ? endOfArithExprTail : endOfArithExprInner, true};
-}
-
-std::tuple<Iterator, bool> SyntacticParser::ArithExprTail(Iterator begin,
-                                                          Iterator end) {
-  if (!ArithOp1(begin)) {
-    return {begin, false};
-  }
-
-  const auto &[endOfArithExprInner, success] = ArithExprInner(begin + 1, end);
-  if (!success) {
-    error(begin, endOfArithExprInner,
-          "expected operand in arithmetic expression");
-    exit(1);
-  }
-
-  entries.emplace_back(Entry::EntryType::COMMAND, begin->value == "+"
-                                                      ? Entry::Command::ADD
-                                                      : Entry::Command::SUB);
-
-  const auto &[endOfArithExprTail, success2] =
-      ArithExprTail(endOfArithExprInner + 1, end);
-  return {success2 ? endOfArithExprTail : endOfArithExprInner, true};
+Result SyntacticParser::ArithExpr(Iterator begin, Iterator end) {
+  return Expression(begin, end, Expr::ARITHMETIC, 1);
 }
 
-std::tuple<Iterator, bool> SyntacticParser::ArithExprInner(Iterator begin,
-                                                           Iterator end) {
-  const auto &[endOfArithUnit, success1] = ArithUnit(begin, end);
-  if (!success1) {
-    return {begin, false};
-  }
-
-  const auto &[endOfArithExprInnerTail, success2] =
-      ArithExprInnerTail(endOfArithUnit + 1, end);
-  return {success2 ? endOfArithExprInnerTail : endOfArithUnit, true};
-}
-
-std::tuple<Iterator, bool> SyntacticParser::ArithExprInnerTail(Iterator begin,
-                                                               Iterator end) {
-  if (!ArithOp2(begin)) {
-    return {begin, false};
-  }
-
-  const auto &[endOfArithUnit, success] = ArithUnit(begin + 1, end);
-  if (!success) {
-    error(begin, endOfArithUnit, "expected operand in arithmetic expression");
-    exit(1);
-  }
-
-  entries.emplace_back(Entry::EntryType::COMMAND, begin->value == "*"
-                                                      ? Entry::Command::MUL
-                                                      : Entry::Command::DIV);
-
-  const auto &[endOfArithExprInnerTail, success2] =
-      ArithExprInnerTail(endOfArithUnit + 1, end);
-  return {success2 ? endOfArithExprInnerTail : endOfArithUnit, true};
-}
-
-std::tuple<Iterator, bool> SyntacticParser::ArithUnit(Iterator begin,
-                                                      Iterator end) {
+Result SyntacticParser::ArithUnit(Iterator begin, Iterator end) {
   if (Operand(begin)) {
     return {begin, true};
   }
@@ -332,14 +291,15 @@ std::tuple<Iterator, bool> SyntacticParser::ArithUnit(Iterator begin,
 
   const auto &[endOfArithExpr, success] = ArithExpr(begin + 1, end);
   if (!success) {
-    error(begin, endOfArithExpr, "expected arithmetic expression after '(");
-    exit(1);
+    return {Recover(endOfArithExpr, end,
+                    "expected arithmetic expression after '('"),
+            true};
   }
 
   if (!ClosingParenthesis(endOfArithExpr + 1)) {
-    error(begin, endOfArithExpr + 1,
-          "expected ')' after arithmetic expression");
-    exit(1);
+    return {Recover(endOfArithExpr + 1, end,
+                    "expected ')' after arithmetic expression"),
+            true};
   }
 
   return {endOfArithExpr + 1, true};
@@ -350,90 +310,111 @@ bool SyntacticParser::Operand(Iterator begin) {
 }
 
 bool SyntacticParser::Identifier(Iterator begin) {
-  if (begin->category != Lexeme::Category::IDENTIFIER) {
+  if (tokens.Category(begin) != Lexeme::Category::IDENTIFIER) {
     return false;
   }
 
-  entries.emplace_back(Entry::EntryType::VARIABLE, begin->value);
+  entries.emplace_back(Entry::EntryType::VARIABLE,
+                       symbols.Intern(tokens.Value(begin)));
   return true;
 }
 
 bool SyntacticParser::Constant(Iterator begin) {
-  if (begin->category != Lexeme::Category::CONSTANT) {
+  if (tokens.Category(begin) != Lexeme::Category::CONSTANT) {
     return false;
   }
 
-  entries.emplace_back(Entry::EntryType::CONSTANT, std::stoi(begin->value));
+  int value = 0;
+  std::string_view text = tokens.Value(begin);
+  std::from_chars(text.data(), text.data() + text.size(), value);
+  entries.emplace_back(Entry::EntryType::CONSTANT, value);
   return true;
 }
 
-bool SyntacticParser::ArithOp1(Iterator begin) {
-  return begin->type == Lexeme::Type::ARITHMETIC_SIMPLE;
-}
-
-bool SyntacticParser::ArithOp2(Iterator begin) {
-  return begin->type == Lexeme::Type::ARITHMETIC_DIFICULT;
-}
-
-bool SyntacticParser::LogOp1(Iterator begin) {
-  return begin->type == Lexeme::Type::OR;
-}
-
-bool SyntacticParser::LogOp2(Iterator begin) {
-  return begin->type == Lexeme::Type::AND;
-}
-
 bool SyntacticParser::OpeningParenthesis(Iterator begin) {
-  return begin->type == Lexeme::Type::BRACKET && begin->value == "(";
+  return tokens.Type(begin) == Lexeme::Type::BRACKET &&
+         tokens.Value(begin) == "(";
 }
 
 bool SyntacticParser::ClosingParenthesis(Iterator begin) {
-  return begin->type == Lexeme::Type::BRACKET && begin->value == ")";
+  return tokens.Type(begin) == Lexeme::Type::BRACKET &&
+         tokens.Value(begin) == ")";
 }
 
 bool SyntacticParser::Semicolon(Iterator begin) {
-  return begin->type == Lexeme::Type::SEPARATOR;
+  return tokens.Type(begin) == Lexeme::Type::SEPARATOR;
 }
 
 bool SyntacticParser::AssignmentOp(Iterator begin) {
-  return begin->type == Lexeme::Type::ASSIGNMENT;
+  return tokens.Type(begin) == Lexeme::Type::ASSIGNMENT;
 }
 
 bool SyntacticParser::InputOp(Iterator begin) {
-  return begin->type == Lexeme::Type::INPUT;
+  return tokens.Type(begin) == Lexeme::Type::INPUT;
 }
 
 bool SyntacticParser::OutputOp(Iterator begin) {
-  return begin->type == Lexeme::Type::OUTPUT;
+  return tokens.Type(begin) == Lexeme::Type::OUTPUT;
 }
 
 bool SyntacticParser::If(Iterator begin) {
-  return begin->type == Lexeme::Type::IF;
+  return tokens.Type(begin) == Lexeme::Type::IF;
 }
 
 bool SyntacticParser::Then(Iterator begin) {
-  return begin->type == Lexeme::Type::THEN;
+  return tokens.Type(begin) == Lexeme::Type::THEN;
 }
 
 bool SyntacticParser::End(Iterator begin) {
-  return begin->type == Lexeme::Type::END;
+  return tokens.Type(begin) == Lexeme::Type::END;
 }
 
 bool SyntacticParser::ElseIf(Iterator begin) {
-  return begin->type == Lexeme::Type::ELSEIF;
+  return tokens.Type(begin) == Lexeme::Type::ELSEIF;
 }
 
 bool SyntacticParser::Else(Iterator begin) {
-  return begin->type == Lexeme::Type::ELSE;
+  return tokens.Type(begin) == Lexeme::Type::ELSE;
+}
+
+bool SyntacticParser::Synchronizing(Iterator begin) {
+  return Semicolon(begin) || End(begin) || ElseIf(begin) || Else(begin);
 }
 
-std::tuple<std::vector<Entry>, bool>
-SyntacticParser::Parse(const std::string &text) {
-  auto lexemes = lexer.Analyse(text);
+ParseResult SyntacticParser::Parse(std::string_view text) {
+  ParseResult result;
+  result.success = Parse(text, result.entries, result.diagnostics);
+  return result;
+}
+
+// NOTE: given buffers are swapped in for the time of parsing, so they are
+// filled in place and keep their capacity
+bool SyntacticParser::Parse(std::string_view text, std::vector<Entry> &output,
+                            std::vector<Diagnostic> &errors) {
+  entries.swap(output);
+  diagnostics.swap(errors);
+
+  source.assign(text);
+  entries.clear();
+  symbols.Clear();
+  diagnostics.clear();
+  lexer.Tokenize(source, tokens, diagnostics);
+  entries.reserve(tokens.Size());
+  synchronized = tokens.Size() + 1;
 
-  auto begin = lexemes.begin();
-  auto end = lexemes.end();
+  Iterator begin = 0;
+  Iterator end = tokens.Size();
+  std::size_t reported = diagnostics.size();
   const auto &[endOfIfStatement, success] = IfStatement(begin, end);
+  if (!success) {
+    Report(begin, "expected 'if' statement");
+  } else if (endOfIfStatement + 1 < end && diagnostics.size() == reported) {
+    // NOTE: program is the only statement, nothing may follow its 'end'.
+    // After syntax errors the rest is mostly their consequence
+    Report(endOfIfStatement + 1, "expected end of text");
+  }
 
-  return {entries, success};
+  entries.swap(output);
+  diagnostics.swap(errors);
+  return errors.empty();
 }
@@ -3,36 +3,51 @@
 #include "../../lexical_analyzer/src/analyzer.h"
 #include "entry.h"
 
+#include <tuple>
+
+// NOTE: program is correct only if there are no diagnostics, lexical ones
+// come first
+struct ParseResult {
+  std::vector<Entry> entries;
+  bool success = false;
+  std::vector<Diagnostic> diagnostics;
+};
+
+// NOTE: every call of Parse starts from scratch, symbols and entries of the
+// previous program are dropped. Parse into caller buffers reuses all memory,
+// so in steady state it does not allocate
 class SyntacticParser {
 public:
-  auto Parse(const std::string &text) -> std::tuple<std::vector<Entry>, bool>;
+  using Iterator = TokenBuffer::Index;
+  // NOTE: last token of parsed construction and success
+  using Result = std::tuple<Iterator, bool>;
+  // NOTE: conditions are built of relations by 'or' and 'and', arithmetic
+  // expressions of operands and parenthesized expressions by '+', '-', '*'
+  // and '/'
+  enum class Expr { LOGICAL, ARITHMETIC };
+
+  auto Parse(std::string_view text) -> ParseResult;
+  bool Parse(std::string_view text, std::vector<Entry> &entries,
+             std::vector<Diagnostic> &diagnostics);
 
 private:
-  using Iterator = std::vector<Lexeme>::iterator;
-  auto IfStatement(Iterator begin, Iterator end) -> std::tuple<Iterator, bool>;
-  auto AlterIfStatement(Iterator begin,
-                        Iterator end) -> std::tuple<Iterator, bool>;
-  auto LogExpr(Iterator begin, Iterator end) -> std::tuple<Iterator, bool>;
-  auto LogExprTail(Iterator begin, Iterator end) -> std::tuple<Iterator, bool>;
-  auto LogExprInner(Iterator begin, Iterator end) -> std::tuple<Iterator, bool>;
-  auto LogExprInnerTail(Iterator begin,
-                        Iterator end) -> std::tuple<Iterator, bool>;
-  auto RelExpr(Iterator begin, Iterator end) -> std::tuple<Iterator, bool>;
+  auto Recover(Iterator at, Iterator end, const char *reason) -> Iterator;
+  void Report(Iterator at, const char *reason);
+  auto IfStatement(Iterator begin, Iterator end) -> Result;
+  auto AlterIfStatement(Iterator begin, Iterator end, int &exits) -> Result;
+  auto Expression(Iterator begin, Iterator end, Expr expression,
+                  int precedence) -> Result;
+  // NOTE: binding power of binary operator of expression at token, 0 if
+  // there is none
+  auto Precedence(Iterator at, Expr expression) -> int;
+  auto Operation(Iterator op) -> Entry::Command;
+  auto LogExpr(Iterator begin, Iterator end) -> Result;
+  auto RelExpr(Iterator begin, Iterator end) -> Result;
   auto RelOp(Iterator begin) -> bool;
-  auto Statement(Iterator begin, Iterator end) -> std::tuple<Iterator, bool>;
-  auto Instruction(Iterator begin, Iterator end) -> std::tuple<Iterator, bool>;
-  auto ArithExpr(Iterator begin, Iterator end) -> std::tuple<Iterator, bool>;
-  auto ArithExprTail(Iterator begin,
-                     Iterator end) -> std::tuple<Iterator, bool>;
-  auto ArithExprInner(Iterator begin,
-                      Iterator end) -> std::tuple<Iterator, bool>;
-  auto ArithExprInnerTail(Iterator begin,
-                          Iterator end) -> std::tuple<Iterator, bool>;
-  auto ArithUnit(Iterator begin, Iterator end) -> std::tuple<Iterator, bool>;
-  auto ArithOp1(Iterator begin) -> bool;
-  auto ArithOp2(Iterator begin) -> bool;
-  auto LogOp1(Iterator begin) -> bool;
-  auto LogOp2(Iterator begin) -> bool;
+  auto Statement(Iterator begin, Iterator end) -> Result;
+  auto Instruction(Iterator begin, Iterator end) -> Result;
+  auto ArithExpr(Iterator begin, Iterator end) -> Result;
+  auto ArithUnit(Iterator begin, Iterator end) -> Result;
   auto Operand(Iterator begin) -> bool;
   auto Identifier(Iterator begin) -> bool;
   auto Constant(Iterator begin) -> bool;
@@ -47,8 +62,16 @@ private:
   auto End(Iterator begin) -> bool;
   auto ElseIf(Iterator begin) -> bool;
   auto Else(Iterator begin) -> bool;
+  auto Synchronizing(Iterator begin) -> bool;
 
 public:
   LexicalAnalyzer lexer;
+  // NOTE: tokens refer to this copy of parsed text
+  std::string source;
+  TokenBuffer tokens;
   std::vector<Entry> entries;
+  SymbolTable symbols;
+  std::vector<Diagnostic> diagnostics;
+  // NOTE: token on which parser resumed after the last error
+  Iterator synchronized;
 };
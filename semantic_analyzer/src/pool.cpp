@@ -0,0 +1,39 @@
+#include "pool.h"
+
+ParserPool::Lease::Lease(ParserPool &pool,
+                         std::unique_ptr<SyntacticParser> parser)
+    : pool(&pool), parser(std::move(parser)) {}
+
+ParserPool::Lease::~Lease() {
+  if (parser) {
+    pool->Release(std::move(parser));
+  }
+}
+
+ParserPool::Lease ParserPool::Acquire() {
+  std::unique_ptr<SyntacticParser> parser;
+
+  {
+    std::lock_guard lock(mutex);
+    if (!idle.empty()) {
+      parser = std::move(idle.back());
+      idle.pop_back();
+    }
+  }
+
+  if (!parser) {
+    parser = std::make_unique<SyntacticParser>();
+  }
+
+  return {*this, std::move(parser)};
+}
+
+std::size_t ParserPool::Idle() {
+  std::lock_guard lock(mutex);
+  return idle.size();
+}
+
+void ParserPool::Release(std::unique_ptr<SyntacticParser> parser) {
+  std::lock_guard lock(mutex);
+  idle.push_back(std::move(parser));
+}
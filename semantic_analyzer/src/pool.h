@@ -0,0 +1,40 @@
+#pragma once
+
+#include "parser.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// NOTE: parsers for concurrent use. Each lease owns its parser exclusively
+// and gives it back on destruction, so memory grown by one parse is reused
+// by the next one, whichever thread makes it
+class ParserPool {
+public:
+  class Lease {
+  public:
+    Lease(ParserPool &pool, std::unique_ptr<SyntacticParser> parser);
+    Lease(Lease &&other) = default;
+    Lease &operator=(Lease &&other) = delete;
+    ~Lease();
+
+    SyntacticParser &operator*() const { return *parser; }
+    SyntacticParser *operator->() const { return parser.get(); }
+
+  private:
+    ParserPool *pool;
+    std::unique_ptr<SyntacticParser> parser;
+  };
+
+public:
+  // NOTE: new parser is created only when all of them are leased
+  Lease Acquire();
+  std::size_t Idle();
+
+private:
+  void Release(std::unique_ptr<SyntacticParser> parser);
+
+private:
+  std::mutex mutex;
+  std::vector<std::unique_ptr<SyntacticParser>> idle;
+};
@@ -0,0 +1,57 @@
+#include "symbols.h"
+
+#include <algorithm>
+#include <functional>
+
+Symbol SymbolTable::Intern(std::string_view name) {
+  // NOTE: table is kept at most half full
+  if (2 * (Size() + 1) > slots.size()) {
+    Grow();
+  }
+
+  const std::size_t mask = slots.size() - 1;
+
+  for (std::size_t i = std::hash<std::string_view>{}(name) & mask;;
+       i = (i + 1) & mask) {
+    if (slots[i] == EMPTY) {
+      Symbol symbol = static_cast<Symbol>(Size());
+      characters.append(name);
+      offsets.push_back(static_cast<std::uint32_t>(characters.size()));
+      slots[i] = symbol;
+      return symbol;
+    }
+    if (Name(slots[i]) == name) {
+      return slots[i];
+    }
+  }
+}
+
+std::string_view SymbolTable::Name(Symbol symbol) const {
+  std::size_t index = static_cast<std::size_t>(symbol);
+  return std::string_view(characters)
+      .substr(offsets[index], offsets[index + 1] - offsets[index]);
+}
+
+std::size_t SymbolTable::Size() const { return offsets.size() - 1; }
+
+void SymbolTable::Clear() {
+  characters.clear();
+  offsets.resize(1);
+  std::fill(slots.begin(), slots.end(), EMPTY);
+}
+
+void SymbolTable::Grow() {
+  slots.assign(std::max<std::size_t>(16, 2 * slots.size()), EMPTY);
+
+  const std::size_t mask = slots.size() - 1;
+
+  for (std::size_t symbol = 0; symbol < Size(); ++symbol) {
+    std::size_t i =
+        std::hash<std::string_view>{}(Name(static_cast<Symbol>(symbol))) &
+        mask;
+    while (slots[i] != EMPTY) {
+      i = (i + 1) & mask;
+    }
+    slots[i] = static_cast<Symbol>(symbol);
+  }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// NOTE: dense id of interned identifier, ids go from 0 in order of first
+// occurrence, so they may index plain arrays
+enum class Symbol : std::uint32_t {};
+
+class SymbolTable {
+public:
+  Symbol Intern(std::string_view name);
+  std::string_view Name(Symbol symbol) const;
+  std::size_t Size() const;
+  // NOTE: keeps capacity, so table refilled with names of the same amount
+  // does not allocate
+  void Clear();
+
+private:
+  void Grow();
+
+private:
+  static constexpr Symbol EMPTY = static_cast<Symbol>(UINT32_MAX);
+
+  // NOTE: names are stored back to back, name of symbol `i` spans from
+  // offsets[i] to offsets[i + 1]; slots is open addressing hash table of
+  // symbols with power of two size
+  std::string characters;
+  std::vector<std::uint32_t> offsets{0};
+  std::vector<Symbol> slots;
+};
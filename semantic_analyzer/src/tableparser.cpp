@@ -0,0 +1,115 @@
+#include "tableparser.h"
+#include <charconv>
+
+void TableParser::Act(language::Action action, TokenBuffer::Index token) {
+  using language::Action;
+
+  std::string_view value = tokens.Value(token);
+
+  switch (action) {
+  case Action::If:
+    exits.push_back(-1);
+    break;
+  case Action::JumpIfFalse:
+    conditions.push_back(entries.size());
+    entries.emplace_back(Entry::EntryType::INSTRUCTION_POINTER, -1);
+    entries.emplace_back(Entry::EntryType::COMMAND, Entry::Command::JZ);
+    break;
+  case Action::JumpToEnd:
+    JumpToEnd(entries, exits.back());
+    entries[conditions.back()].data = static_cast<int>(entries.size());
+    conditions.pop_back();
+    break;
+  case Action::EndIf:
+    Backpatch(entries, exits.back(), static_cast<int>(entries.size()));
+    exits.pop_back();
+    break;
+  case Action::Or:
+    EmitOperation(entries, Entry::Command::OR);
+    break;
+  case Action::And:
+    EmitOperation(entries, Entry::Command::AND);
+    break;
+  case Action::Relation:
+    EmitOperation(entries, value == ">"    ? Entry::Command::CMPG
+                           : value == "<"  ? Entry::Command::CMPL
+                           : value == "==" ? Entry::Command::CMPE
+                                           : Entry::Command::CMPNE);
+    break;
+  case Action::Assignment:
+    entries.emplace_back(Entry::EntryType::COMMAND, Entry::Command::MOV);
+    break;
+  case Action::Input:
+    entries.emplace_back(Entry::EntryType::COMMAND, Entry::Command::INPUT);
+    break;
+  case Action::Output:
+    entries.emplace_back(Entry::EntryType::COMMAND, Entry::Command::OUTPUT);
+    break;
+  case Action::Arithmetic:
+    EmitOperation(entries, value == "+"   ? Entry::Command::ADD
+                           : value == "-" ? Entry::Command::SUB
+                           : value == "*" ? Entry::Command::MUL
+                                          : Entry::Command::DIV);
+    break;
+  case Action::Constant: {
+    int constant = 0;
+    std::from_chars(value.data(), value.data() + value.size(), constant);
+    entries.emplace_back(Entry::EntryType::CONSTANT, constant);
+    break;
+  }
+  case Action::Variable:
+    entries.emplace_back(Entry::EntryType::VARIABLE, symbols.Intern(value));
+    break;
+  }
+}
+
+void TableParser::Report(const Mismatch &mismatch) {
+  // NOTE: erroneous lexemes are already reported by lexer
+  if (tokens.Type(mismatch.token) == Lexeme::Type::ERROR) {
+    return;
+  }
+
+  bool is_token = mismatch.token < tokens.Size();
+  Diagnostic diagnostic =
+      Locate(source, is_token ? tokens.Offset(mismatch.token) : source.size());
+  diagnostic.message =
+      "syntax error: expected " + Expected(mismatch.expected) +
+      (is_token ? " near '" + std::string(tokens.Value(mismatch.token)) + "'"
+                : std::string(" at the end of text"));
+  diagnostics.push_back(std::move(diagnostic));
+}
+
+ParseResult TableParser::Parse(std::string_view text) {
+  ParseResult result;
+  result.success = Parse(text, result.entries, result.diagnostics);
+  return result;
+}
+
+// NOTE: given buffers are swapped in for the time of parsing, so they are
+// filled in place and keep their capacity
+bool TableParser::Parse(std::string_view text, std::vector<Entry> &output,
+                        std::vector<Diagnostic> &errors) {
+  entries.swap(output);
+  diagnostics.swap(errors);
+
+  source.assign(text);
+  entries.clear();
+  symbols.Clear();
+  diagnostics.clear();
+  conditions.clear();
+  exits.clear();
+  lexer.Tokenize(source, tokens, diagnostics);
+  entries.reserve(tokens.Size());
+
+  auto mismatch = driver.Parse(
+      tokens, [this](language::Action action, TokenBuffer::Index token) {
+        Act(action, token);
+      });
+  if (mismatch) {
+    Report(*mismatch);
+  }
+
+  entries.swap(output);
+  diagnostics.swap(errors);
+  return errors.empty();
+}
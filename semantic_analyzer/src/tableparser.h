@@ -0,0 +1,35 @@
+#pragma once
+
+#include "../../parser_generator/src/ll1.h"
+#include "parser.h"
+
+// NOTE: front end driven by LL(1) table generated from
+// parser_generator/grammars/language.ll1, entries are emitted by actions of
+// grammar and match the ones of SyntacticParser. It stops at the first
+// error, but its nesting is not limited by call stack
+class TableParser {
+public:
+  auto Parse(std::string_view text) -> ParseResult;
+  bool Parse(std::string_view text, std::vector<Entry> &entries,
+             std::vector<Diagnostic> &diagnostics);
+
+private:
+  void Act(language::Action action, TokenBuffer::Index token);
+  void Report(const Mismatch &mismatch);
+
+public:
+  LexicalAnalyzer lexer;
+  // NOTE: tokens refer to this copy of parsed text
+  std::string source;
+  TokenBuffer tokens;
+  std::vector<Entry> entries;
+  SymbolTable symbols;
+  std::vector<Diagnostic> diagnostics;
+
+private:
+  LL1Parser driver;
+  // NOTE: operands of pending JZ and backpatch chains of unfinished 'if'
+  // statements, innermost last
+  std::vector<std::size_t> conditions;
+  std::vector<int> exits;
+};
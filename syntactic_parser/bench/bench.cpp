@@ -0,0 +1,21 @@
+#include "../src/parser.h"
+#include "../src/tableparser.h"
+#include "measure.h"
+
+// NOTE: lexing, parsing and building of tree are measured together, the
+// same parser is reused between runs as editor would do
+static void MeasureParsers(const std::string &name, const std::string &text) {
+  SyntacticParser parser;
+  TableParser table_parser;
+
+  Measure(name + " Parse", text, [&] {
+    return parser.Parse(text).success ? parser.tokens.Size() : 0;
+  });
+  Measure(name + " TableParser", text, [&] {
+    return table_parser.Parse(text).success ? table_parser.tokens.Size() : 0;
+  });
+}
+
+int main(int argc, char **argv) {
+  return RunBenchmark(argc, argv, MeasureParsers);
+}
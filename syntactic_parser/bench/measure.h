@@ -0,0 +1,80 @@
+#pragma once
+
+#include "programs.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+// NOTE: timing and driver shared by parser benchmarks of both front ends,
+// which only tell how their parsers are run on a program
+
+constexpr std::size_t DEFAULT_SIZE = 4 << 20;
+constexpr int RUNS = 5;
+
+// NOTE: run returns number of tokens, or 0 if program is rejected
+inline void Measure(const std::string &name, std::string_view text,
+                    const std::function<std::size_t()> &run) {
+  double best = 0;
+  std::size_t tokens = 0;
+
+  for (int i = 0; i < RUNS; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    tokens = run();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (i == 0 || elapsed.count() < best) {
+      best = elapsed.count();
+    }
+  }
+
+  if (tokens == 0) {
+    std::cerr << name << ": program is rejected" << std::endl;
+    std::exit(1);
+  }
+
+  std::cout << std::left << std::setw(24) << name << std::right
+            << std::setw(12) << tokens << " tokens" << std::fixed
+            << std::setprecision(1) << std::setw(10) << tokens / best / 1e6
+            << " Mtokens/s" << std::setw(10) << text.size() / best / 1e6
+            << " MB/s\n";
+}
+
+// NOTE: usage: parser_bench [file]; without file parses generated programs
+// of 4 MB of every shape. measure_parsers gets name and text of program
+inline int RunBenchmark(
+    int argc, char **argv,
+    const std::function<void(const std::string &, const std::string &)>
+        &measure_parsers) {
+  if (argc > 1) {
+    std::ifstream file(argv[1], std::ios::binary);
+    if (!file) {
+      std::cerr << "can't open '" << argv[1] << "'" << std::endl;
+      return 1;
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+
+    std::cout << "best of " << RUNS << " runs\n";
+    measure_parsers("file", content.str());
+    return 0;
+  }
+
+  std::cout << "input: " << DEFAULT_SIZE << " bytes per shape, best of "
+            << RUNS << " runs\n";
+
+  ProgramGenerator generator;
+  for (std::size_t shape = 0; shape < std::size(SHAPE_NAMES); ++shape) {
+    measure_parsers(
+        std::string(SHAPE_NAMES[shape]),
+        generator.Generate(static_cast<Shape>(shape), DEFAULT_SIZE));
+  }
+  return 0;
+}
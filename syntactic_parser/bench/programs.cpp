@@ -0,0 +1,38 @@
+#include "programs.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+// NOTE: whole argument must be decimal number
+template <typename T> static bool Number(const char *argument, T &value) {
+  const char *end = argument + std::strlen(argument);
+  auto [last, error] = std::from_chars(argument, end, value);
+  return error == std::errc() && last == end && last != argument;
+}
+
+// NOTE: usage: parser_programs <shape> [bytes] [seed]; writes generated
+// program to stdout, so corpora can be kept as files for parser_bench
+int main(int argc, char **argv) {
+  const auto *shape =
+      argc > 1 ? std::find(std::begin(SHAPE_NAMES), std::end(SHAPE_NAMES),
+                           std::string_view(argv[1]))
+               : std::end(SHAPE_NAMES);
+
+  std::size_t size = 1 << 20;
+  unsigned seed = 42;
+
+  if (shape == std::end(SHAPE_NAMES) || (argc > 2 && !Number(argv[2], size)) ||
+      (argc > 3 && !Number(argv[3], seed))) {
+    std::cerr << "usage: parser_programs "
+                 "<mixed|statements|elseif|expression|nesting> [bytes] "
+                 "[seed]"
+              << std::endl;
+    return 1;
+  }
+
+  std::cout << ProgramGenerator(seed).Generate(
+      static_cast<Shape>(shape - std::begin(SHAPE_NAMES)), size);
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "../../lexical_analyzer/src/lexeme.h"
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <string_view>
+
+// NOTE: shapes of generated programs, each one stresses one construction
+// of the language: realistic mix, long body of one branch, long 'elseif'
+// chain, one huge expression and deeply nested parentheses
+enum class Shape { MIXED, STATEMENTS, ELSEIF, EXPRESSION, NESTING };
+
+constexpr std::string_view SHAPE_NAMES[] = {"mixed", "statements", "elseif",
+                                            "expression", "nesting"};
+
+// NOTE: generates syntactically valid programs of at least `size` bytes,
+// the same seed gives the same programs, so corpora are reproducible
+class ProgramGenerator {
+public:
+  explicit ProgramGenerator(unsigned seed = 42) : random(seed) {}
+
+  std::string Generate(Shape shape, std::size_t size) {
+    std::string text;
+    text.reserve(size + 4096);
+
+    text += "if ";
+    Condition(text, 1 + Below(4));
+    text += " then\n";
+
+    switch (shape) {
+    case Shape::MIXED:
+      Statement(text, 1 + Below(20), 3);
+      while (text.size() < size) {
+        text += "\nelseif ";
+        Condition(text, 1 + Below(4));
+        text += " then\n";
+        Statement(text, 1 + Below(20), 3);
+      }
+      text += "\nelse\n";
+      Statement(text, 1 + Below(20), 3);
+      break;
+    case Shape::STATEMENTS:
+      Statement(text, 1, 3);
+      while (text.size() < size) {
+        text += ";\n";
+        Instruction(text, 3);
+      }
+      break;
+    case Shape::ELSEIF:
+      Statement(text, 1, 3);
+      for (std::size_t branch = 0; text.size() < size; ++branch) {
+        text += "\nelseif ";
+        Identifier(text);
+        text += " == " + std::to_string(branch) + " then\n";
+        Statement(text, 1, 1);
+      }
+      break;
+    case Shape::EXPRESSION:
+      Identifier(text);
+      text += " = ";
+      Operand(text);
+      while (text.size() < size) {
+        text += ' ';
+        text += OPERATORS[Below(std::size(OPERATORS))];
+        text += ' ';
+        if (Below(8) == 0) {
+          text += '(';
+          Expression(text, 2 + Below(6), 2);
+          text += ')';
+        } else {
+          Operand(text);
+        }
+      }
+      break;
+    case Shape::NESTING:
+      Identifier(text);
+      text += " = ";
+      Nested(text, 1 + Below(MAX_DEPTH));
+      while (text.size() < size) {
+        text += ";\n";
+        Identifier(text);
+        text += " = ";
+        Nested(text, 1 + Below(MAX_DEPTH));
+      }
+      break;
+    }
+
+    text += "\nend\n";
+    return text;
+  }
+
+private:
+  static constexpr const char *OPERATORS[] = {"+", "-", "*", "/"};
+  static constexpr const char *RELATIONS[] = {"<", ">", "==", "<>"};
+  // NOTE: recursive parsers spend a few frames per parenthesis, so nesting
+  // is kept well within default stack
+  static constexpr std::size_t MAX_DEPTH = 512;
+
+  std::size_t Below(std::size_t bound) { return random() % bound; }
+
+  void Identifier(std::string &text) {
+    std::size_t begin = text.size();
+
+    do {
+      text.resize(begin);
+      text += static_cast<char>('a' + Below(26));
+      for (std::size_t length = Below(8); length > 0; --length) {
+        text += Below(4) ? static_cast<char>('a' + Below(26))
+                         : static_cast<char>('0' + Below(10));
+      }
+    } while (KeywordType(std::string_view(text).substr(begin)) !=
+             Lexeme::Type::UNDEFINED);
+  }
+
+  void Operand(std::string &text) {
+    if (Below(3) == 0) {
+      text += std::to_string(Below(100000));
+    } else {
+      Identifier(text);
+    }
+  }
+
+  void Expression(std::string &text, std::size_t terms, std::size_t depth) {
+    for (std::size_t term = 0; term < terms; ++term) {
+      if (term) {
+        text += ' ';
+        text += OPERATORS[Below(std::size(OPERATORS))];
+        text += ' ';
+      }
+      if (depth > 0 && Below(4) == 0) {
+        text += '(';
+        Expression(text, 2 + Below(3), depth - 1);
+        text += ')';
+      } else {
+        Operand(text);
+      }
+    }
+  }
+
+  void Nested(std::string &text, std::size_t depth) {
+    for (std::size_t level = 0; level < depth; ++level) {
+      Operand(text);
+      text += ' ';
+      text += OPERATORS[Below(std::size(OPERATORS))];
+      text += " (";
+    }
+    Operand(text);
+    text.append(depth, ')');
+  }
+
+  void Condition(std::string &text, std::size_t relations) {
+    for (std::size_t relation = 0; relation < relations; ++relation) {
+      if (relation) {
+        text += Below(2) ? " and " : " or ";
+      }
+      Operand(text);
+      if (Below(4)) {
+        text += ' ';
+        text += RELATIONS[Below(std::size(RELATIONS))];
+        text += ' ';
+        Operand(text);
+      }
+    }
+  }
+
+  void Instruction(std::string &text, std::size_t depth) {
+    switch (Below(4)) {
+    case 0:
+      text += "input ";
+      Identifier(text);
+      break;
+    case 1:
+      text += "output ";
+      Operand(text);
+      break;
+    default:
+      Identifier(text);
+      text += " = ";
+      Expression(text, 1 + Below(6), depth);
+      break;
+    }
+  }
+
+  void Statement(std::string &text, std::size_t instructions,
+                 std::size_t depth) {
+    for (std::size_t instruction = 0; instruction < instructions;
+         ++instruction) {
+      text += instruction ? ";\n  " : "  ";
+      Instruction(text, depth);
+    }
+  }
+
+private:
+  std::mt19937 random;
+};
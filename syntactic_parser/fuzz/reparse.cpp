@@ -0,0 +1,156 @@
+#include "../bench/programs.h"
+#include "../src/parser.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+// NOTE: differential check of incremental parsing. Random edits are applied
+// by Reparse to generated programs and the result must be the same as full
+// Parse of edited text: success, diagnostics and syntax tree
+
+static void Check(bool condition, const char *what, const std::string &text) {
+  if (!condition) {
+    std::fprintf(stderr, "reparse fuzz: %s on\n%s\n", what, text.c_str());
+    std::abort();
+  }
+}
+
+static std::string Dump(const SyntacticParser &parser) {
+  std::ostringstream out;
+  if (parser.ast.root != Node::NONE) {
+    parser.ast.Print(parser.tokens, out);
+  }
+  return out.str();
+}
+
+static bool Same(const Diagnostic &first, const Diagnostic &second) {
+  return first.line == second.line && first.column == second.column &&
+         first.message == second.message;
+}
+
+// NOTE: usage: parser_reparse [edits] [seed]
+int main(int argc, char **argv) {
+  static const char *const PIECES[] = {
+      "",  " ", "a",   "1", "+", "*",  "(",   ")", ";",  "=",
+      "z", "7", "end", "<", ">", "==", "if ", "\n", "or", "then"};
+  static const std::size_t PROGRAM_SIZE = 256;
+  static const std::size_t EDITS_PER_PROGRAM = 30;
+
+  std::size_t edits = 20000;
+  unsigned seed = 42;
+  if (argc > 1) {
+    std::from_chars(argv[1], argv[1] + std::strlen(argv[1]), edits);
+  }
+  if (argc > 2) {
+    std::from_chars(argv[2], argv[2] + std::strlen(argv[2]), seed);
+  }
+
+  std::mt19937 random(seed);
+  ProgramGenerator generator(seed);
+  auto below = [&](std::size_t bound) { return random() % bound; };
+
+  SyntacticParser incremental;
+  SyntacticParser full;
+  std::string text;
+  std::size_t reparsed = 0;
+  // NOTE: edits made since program was correct, as offset, size of inserted
+  // text and removed one
+  std::vector<std::tuple<std::size_t, std::size_t, std::string>> undo;
+
+  for (std::size_t edit = 0; edit < edits; ++edit) {
+    if (edit % EDITS_PER_PROGRAM == 0) {
+      text = generator.Generate(static_cast<Shape>(below(3)),
+                                1 + below(PROGRAM_SIZE));
+      incremental.Parse(text);
+      undo.clear();
+    }
+
+    // NOTE: offsets past the end of text must be rejected without changes
+    if (below(64) == 0) {
+      std::string before = Dump(incremental);
+      ParseResult result = incremental.Reparse(
+          text.size() + 1 + below(16), below(3), PIECES[below(20)]);
+      Check(!result.success && result.diagnostics.size() == 1 &&
+                incremental.source == text && Dump(incremental) == before,
+            "stale edit changed parser", text);
+      continue;
+    }
+
+    std::size_t offset = below(text.size() + 1);
+    std::size_t removed = below(3) ? below(3) : 0;
+    std::string inserted = PIECES[below(std::size(PIECES))];
+
+    // NOTE: most edits change one symbol of expression assigned by an
+    // instruction to one of the same class, so program stays correct and
+    // the edit is handled without full parse
+    std::size_t assignment = text.find(" = ", offset);
+    if (assignment == std::string::npos) {
+      assignment = text.find(" = ");
+    }
+    if (below(8) != 0 && assignment != std::string::npos) {
+      std::size_t from = assignment + 3;
+      std::size_t to = std::min(text.find_first_of(";\n", from), text.size());
+      offset = from + below(std::max<std::size_t>(to - from, 1));
+      removed = 1;
+      char symbol = text[offset];
+      if (std::isdigit(static_cast<unsigned char>(symbol))) {
+        inserted = std::string(1, static_cast<char>('0' + below(10)));
+      } else if (std::isalpha(static_cast<unsigned char>(symbol))) {
+        inserted = std::string(1, static_cast<char>('a' + below(26)));
+      } else if (std::strchr("+-*/", symbol)) {
+        inserted = std::string(1, "+-*/"[below(4)]);
+      } else {
+        removed = 0;
+        inserted = " ";
+      }
+    }
+
+    // NOTE: edits of incorrect program are all handled by full parse, so it
+    // is mostly restored by undoing them
+    bool undoing = !incremental.valid && !undo.empty() && below(4) != 0;
+    if (undoing) {
+      std::tie(offset, removed, inserted) = undo.back();
+      undo.pop_back();
+    }
+
+    std::size_t released = incremental.ast.Released();
+    ParseResult result = incremental.Reparse(offset, removed, inserted);
+    removed = std::min(removed, text.size() - offset);
+    std::string erased = text.substr(offset, removed);
+    text.replace(offset, removed, inserted);
+    ParseResult expected = full.Parse(text);
+    if (expected.success) {
+      undo.clear();
+    } else if (!undoing) {
+      undo.emplace_back(offset, inserted.size(), std::move(erased));
+    }
+
+    Check(incremental.source == text, "source", text);
+    Check(result.success == expected.success, "success", text);
+    Check(result.diagnostics.size() == expected.diagnostics.size(),
+          "number of diagnostics", text);
+    for (std::size_t i = 0; i < result.diagnostics.size(); ++i) {
+      Check(Same(result.diagnostics[i], expected.diagnostics[i]),
+            "diagnostic", text);
+    }
+    if (result.success) {
+      Check(Dump(incremental) == Dump(full), "syntax tree", text);
+    }
+
+    // NOTE: full parse starts arena anew
+    reparsed += incremental.ast.Released() > released;
+  }
+
+  std::cout << edits << " edits passed, " << reparsed
+            << " reparsed incrementally\n";
+}
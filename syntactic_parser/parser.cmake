@@ -0,0 +1,31 @@
+# NOTE: builds syntactic parser with its LL(1) front end once as library
+# syntactic_parser_core on top of lexer_core. SYNTACTIC_PARSER_SRC lists its
+# own sources for targets which compile them with their own flags
+
+include(${CMAKE_CURRENT_LIST_DIR}/../lexical_analyzer/lexer.cmake)
+include(${CMAKE_CURRENT_LIST_DIR}/../parser_generator/ll1.cmake)
+
+set(SYNTACTIC_PARSER_DIR ${CMAKE_CURRENT_LIST_DIR})
+
+set(SYNTACTIC_PARSER_SRC
+  ${SYNTACTIC_PARSER_DIR}/src/parser.cpp
+  ${SYNTACTIC_PARSER_DIR}/src/tableparser.cpp
+  ${SYNTACTIC_PARSER_DIR}/src/ast.cpp
+)
+
+set(SYNTACTIC_PARSER_HEADER
+  ${SYNTACTIC_PARSER_DIR}/src/parser.h
+  ${SYNTACTIC_PARSER_DIR}/src/tableparser.h
+  ${SYNTACTIC_PARSER_DIR}/src/ast.h
+)
+
+if(NOT TARGET syntactic_parser_core)
+  add_library(syntactic_parser_core ${SYNTACTIC_PARSER_SRC}
+    ${SYNTACTIC_PARSER_HEADER})
+
+  target_compile_options(syntactic_parser_core PRIVATE
+    $<$<NOT:$<CONFIG:Debug>>:-O2>)
+  target_link_libraries(syntactic_parser_core PUBLIC lexer_core)
+
+  target_ll1_grammar(syntactic_parser_core ${LL1_DIR}/grammars/language.ll1)
+endif()
@@ -0,0 +1,89 @@
+#include "ast.h"
+
+#include <algorithm>
+#include <tuple>
+
+static const char *const KINDS[] = {
+    "IF",     "ELSEIF", "ELSE",     "STATEMENT",  "ASSIGNMENT",
+    "INPUT",  "OUTPUT", "OR",       "AND",        "RELATION",
+    "ARITHMETIC",       "IDENTIFIER",             "CONSTANT"};
+
+Node::Index Ast::Add(Node::Kind kind, TokenBuffer::Index token,
+                     std::initializer_list<Node::Index> children) {
+  Node::Index index = static_cast<Node::Index>(nodes.size());
+  nodes.push_back({kind, static_cast<std::int32_t>(token)});
+
+  // NOTE: absent optional children are passed as NONE and skipped
+  Node::Index *link = &nodes.back().first_child;
+  for (Node::Index child : children) {
+    if (child != Node::NONE) {
+      TokenBuffer::Index at = Ast::Token(0, nodes[child]);
+      Link(*link, token, child);
+      link = &nodes[child].next_sibling;
+      token = at;
+    }
+  }
+
+  return index;
+}
+
+void Ast::Clear() {
+  nodes.clear();
+  root = Node::NONE;
+  released = 0;
+}
+
+void Ast::Append(Node::Index parent, TokenBuffer::Index at,
+                 Node::Index child) {
+  Node::Index *link = &nodes[parent].first_child;
+  while (*link != Node::NONE) {
+    at = Token(at, nodes[*link]);
+    link = &nodes[*link].next_sibling;
+  }
+  Link(*link, at, child);
+}
+
+void Ast::Link(Node::Index &link, TokenBuffer::Index at, Node::Index child) {
+  nodes[child].token -= static_cast<std::int32_t>(at);
+  link = child;
+}
+
+void Ast::Release(Node::Index index) {
+  std::vector<Node::Index> pending{nodes[index].first_child};
+  ++released;
+  while (!pending.empty()) {
+    for (index = pending.back(), pending.pop_back(); index != Node::NONE;
+         index = nodes[index].next_sibling) {
+      pending.push_back(nodes[index].first_child);
+      ++released;
+    }
+  }
+}
+
+// NOTE: preorder walk with explicit stack, since chains of operators make
+// trees as deep as they are long
+void Ast::Print(const TokenBuffer &tokens, std::ostream &out) const {
+  std::vector<std::tuple<Node::Index, std::size_t, TokenBuffer::Index>>
+      pending;
+  if (root != Node::NONE) {
+    pending.emplace_back(root, 0, Token(0, nodes[root]));
+  }
+
+  while (!pending.empty()) {
+    const auto [index, depth, token] = pending.back();
+    pending.pop_back();
+
+    const Node &node = nodes[index];
+    out << std::string(2 * depth, ' ') << KINDS[node.kind] << " '"
+        << tokens.Value(token) << "'\n";
+
+    std::size_t first = pending.size();
+    TokenBuffer::Index at = token;
+    for (Node::Index child = node.first_child; child != Node::NONE;
+         child = nodes[child].next_sibling) {
+      at = Token(at, nodes[child]);
+      pending.emplace_back(child, depth + 1, at);
+    }
+    std::reverse(pending.begin() + first, pending.end());
+  }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../../lexical_analyzer/src/tokens.h"
+
+#include <cstdint>
+#include <initializer_list>
+#include <ostream>
+#include <vector>
+
+struct Node {
+  using Index = std::uint32_t;
+  static constexpr Index NONE = UINT32_MAX;
+
+  enum Kind : std::uint8_t {
+    IF,
+    ELSEIF,
+    ELSE,
+    STATEMENT,
+    ASSIGNMENT,
+    INPUT,
+    OUTPUT,
+    OR,
+    AND,
+    RELATION,
+    ARITHMETIC,
+    IDENTIFIER,
+    CONSTANT
+  } kind;
+  // NOTE: keyword, operator or operand which node stands for. It is stored
+  // relative to the previous sibling, or to the parent for the first child,
+  // so edits shift only the nodes which follow the edited one in their lists.
+  // Root and nodes not linked yet hold absolute token
+  std::int32_t token;
+  Index first_child = NONE;
+  Index next_sibling = NONE;
+};
+
+// NOTE: nodes are bump allocated in one vector which keeps its capacity
+// between parses, links between nodes are indices into it. Children of node
+// form a list through next_sibling:
+//   IF / ELSEIF: condition, statement[, ELSEIF or ELSE]
+//   ELSE: statement
+//   STATEMENT: instructions
+//   ASSIGNMENT: identifier, expression; INPUT / OUTPUT: operand
+//   OR / AND / RELATION / ARITHMETIC: left, right (operator is the token)
+class Ast {
+public:
+  Node::Index Add(Node::Kind kind, TokenBuffer::Index token,
+                  std::initializer_list<Node::Index> children = {});
+
+  // NOTE: links child after the last child of parent, `at` is absolute
+  // token of parent
+  void Append(Node::Index parent, TokenBuffer::Index at, Node::Index child);
+  // NOTE: makes link of node with absolute token `at` point to child
+  void Link(Node::Index &link, TokenBuffer::Index at, Node::Index child);
+  // NOTE: subtree replaced by incremental parse stays in arena until Clear,
+  // it is only counted
+  void Release(Node::Index index);
+  std::size_t Released() const { return released; }
+
+  Node &operator[](Node::Index index) { return nodes[index]; }
+  const Node &operator[](Node::Index index) const { return nodes[index]; }
+
+  std::size_t Size() const { return nodes.size(); }
+  void Reserve(std::size_t size) { nodes.reserve(size); }
+  void Clear();
+
+  // NOTE: absolute token of node linked to one with absolute token `at`
+  static TokenBuffer::Index Token(TokenBuffer::Index at, const Node &node) {
+    return at + static_cast<TokenBuffer::Index>(node.token);
+  }
+
+  void Print(const TokenBuffer &tokens, std::ostream &out) const;
+
+public:
+  Node::Index root = Node::NONE;
+
+private:
+  std::vector<Node> nodes;
+  std::size_t released = 0;
+};
@@ -1,12 +1,59 @@
 #include "parser.h"
+#include "tableparser.h"
+#include <charconv>
+#include <cstring>
 #include <iostream>
 
+// NOTE: whole argument must be decimal number
+static bool Number(const char *argument, std::size_t &value) {
+  const char *end = argument + std::strlen(argument);
+  auto [last, error] = std::from_chars(argument, end, value);
+  return error == std::errc() && last == end && last != argument;
+}
+
 int main(int argc, char **argv) {
   SyntacticParser parser;
 
-  if (parser.Parse(argv[1])) {
-    std::cout << "OK\n";
+  // NOTE: `--ast <program>` also prints syntax tree of program
+  bool print_ast = argc > 2 && std::string(argv[1]) == "--ast";
+  // NOTE: `--edit <offset> <removed> <inserted> <program>` parses program,
+  // then replaces `removed` symbols at `offset` by `inserted` and reparses it
+  bool edit = argc > 5 && std::string(argv[1]) == "--edit";
+  // NOTE: `--ll1 <program>` recognizes program by generated LL(1) table
+  bool ll1 = argc > 2 && std::string(argv[1]) == "--ll1";
+
+  std::size_t offset = 0;
+  std::size_t removed = 0;
+  if (edit && !(Number(argv[2], offset) && Number(argv[3], removed))) {
+    std::cerr << "usage: parser --edit <offset> <removed> <inserted> "
+                 "<program>, offset and removed are decimal numbers"
+              << std::endl;
+    return 2;
+  }
+
+  ParseResult result;
+  if (ll1) {
+    result = TableParser().Parse(argv[2]);
   } else {
-    std::cout << "NOT OK\n";
+    result = parser.Parse(argv[print_ast ? 2 : edit ? 5 : 1]);
+  }
+  if (edit) {
+    result = parser.Reparse(offset, removed, argv[4]);
   }
+
+  for (const Diagnostic &diagnostic : result.diagnostics) {
+    std::cerr << diagnostic.line << ":" << diagnostic.column << ": "
+              << diagnostic.message << std::endl;
+  }
+
+  if (result.success) {
+    if (print_ast) {
+      parser.ast.Print(parser.tokens, std::cout);
+    }
+    std::cout << "OK\n";
+    return 0;
+  }
+
+  std::cout << "NOT OK\n";
+  return 1;
 }
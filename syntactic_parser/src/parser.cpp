@@ -1,374 +1,701 @@
 #include "parser.h"
-#include <iostream>
+#include <algorithm>
 
-using Iterator = std::vector<Lexeme>::iterator;
+using Iterator = SyntacticParser::Iterator;
+using Result = SyntacticParser::Result;
 
-static void error(Iterator iter, const Iterator end,
-                  const std::string &reason) {
-  std::cerr << "syntax error: " << reason << '\n';
-  for (auto item = iter; item != end; ++item) {
-    std::cerr << item->value << ' ';
+void SyntacticParser::Report(Iterator at, const char *reason) {
+  // NOTE: erroneous lexemes are already reported by lexer
+  if (tokens.Type(at) == Lexeme::Type::ERROR) {
+    return;
   }
-  std::cerr << "\033[1;31m" << end->value << "\033[0m\n";
+
+  bool is_token = at < tokens.Size();
+  Diagnostic diagnostic =
+      Locate(source, is_token ? tokens.Offset(at) : source.size());
+  diagnostic.message =
+      std::string("syntax error: ") + reason +
+      (is_token ? " near '" + std::string(tokens.Value(at)) + "'"
+                : std::string(" at the end of text"));
+  diagnostics.push_back(std::move(diagnostic));
+}
+
+// NOTE: panic mode, tokens are skipped up to the nearest ';', 'end',
+// 'elseif' or 'else', and the caller goes on as if its construction ended
+// right before it. Errors on that token are consequences of the skipped ones,
+// so they are not reported
+Iterator SyntacticParser::Recover(Iterator at, Iterator end,
+                                  const char *reason) {
+  at = std::min(at, end);
+  if (at != synchronized) {
+    Report(at, reason);
+  }
+
+  Iterator sync = at;
+  while (sync < end && !Synchronizing(sync)) {
+    ++sync;
+  }
+
+  synchronized = sync;
+  return sync - 1;
 }
 
-std::tuple<Iterator, bool> SyntacticParser::IfStatement(Iterator begin,
-                                                        Iterator end) {
+Result SyntacticParser::IfStatement(Iterator begin, Iterator end) {
   if (!If(begin)) {
-    return {begin, false};
+    return {begin, false, Node::NONE};
   }
 
-  const auto &[endOfLogExpr, success1] = LogExpr(begin + 1, end);
+  const auto &[endOfLogExpr, success1, condition] = LogExpr(begin + 1, end);
+  Iterator endOfCondition = endOfLogExpr + 1;
   if (!success1) {
-    error(begin, endOfLogExpr + 1,
-          "expected logical expression as condition in 'if' statement");
-    exit(1);
-  }
-
-  if (!Then(endOfLogExpr + 1)) {
-    error(begin, endOfLogExpr + 1,
-          "expected keyword 'then' after condition of 'if' statement");
-    exit(1);
+    endOfCondition = Recover(
+        endOfLogExpr, end,
+        "expected logical expression as condition in 'if' statement");
+  } else if (!Then(endOfLogExpr + 1)) {
+    endOfCondition =
+        Recover(endOfLogExpr + 1, end,
+                "expected keyword 'then' after condition of 'if' statement");
   }
 
-  const auto &[endOfStatement, success2] = Statement(endOfLogExpr + 2, end);
+  const auto &[endOfStatement, success2, statement] =
+      Statement(endOfCondition + 1, end);
+  Iterator endOfBody = endOfStatement;
   if (!success2) {
-    error(begin, endOfStatement, "expected statement in 'if' body");
-    exit(1);
+    endOfBody = Recover(endOfStatement, end, "expected statement in 'if' body");
   }
 
-  const auto &[endOfOptionalAlterIfStatement, success3] =
-      AlterIfStatement(endOfStatement + 1, end);
+  const auto &[endOfOptionalAlterIfStatement, success3, alternative] =
+      AlterIfStatement(endOfBody + 1, end);
+  Node::Index node =
+      ast.Add(Node::IF, begin, {condition, statement, alternative});
 
   if (!End(endOfOptionalAlterIfStatement + 1)) {
-    error(begin, endOfOptionalAlterIfStatement + 1,
-          "expected keyword 'end' after 'if' body");
-    exit(1);
+    return {Recover(endOfOptionalAlterIfStatement + 1, end,
+                    "expected keyword 'end' after 'if' body"),
+            true, node};
   }
-  return {endOfOptionalAlterIfStatement + 1, true};
+  return {endOfOptionalAlterIfStatement + 1, true, node};
 }
 
-std::tuple<Iterator, bool> SyntacticParser::AlterIfStatement(Iterator begin,
-                                                             Iterator end) {
-  if (ElseIf(begin)) {
-    const auto &[endOfLogExpr, success1] = LogExpr(begin + 1, end);
+// NOTE: on failure returns token before `begin`, which is the last one of
+// preceding construction. Chain of 'elseif' is parsed in a loop, every
+// branch is appended to the previous one as its last child
+Result SyntacticParser::AlterIfStatement(Iterator begin, Iterator end) {
+  Node::Index first = Node::NONE;
+  Node::Index last = Node::NONE;
+  Iterator lastAt = begin;
+  Iterator at = begin;
+
+  while (ElseIf(at)) {
+    const auto &[endOfLogExpr, success1, condition] = LogExpr(at + 1, end);
+    Iterator endOfCondition = endOfLogExpr + 1;
     if (!success1) {
-      error(begin + 1, endOfLogExpr,
-            "expected logical expression as condition in 'elseif' statement");
-      exit(1);
-    }
-    if (!Then(endOfLogExpr + 1)) {
-      error(begin, endOfLogExpr + 1,
-            "expected keyword 'then' after condition of 'elseif' statement");
-      exit(1);
+      endOfCondition = Recover(
+          endOfLogExpr, end,
+          "expected logical expression as condition in 'elseif' statement");
+    } else if (!Then(endOfLogExpr + 1)) {
+      endOfCondition = Recover(
+          endOfLogExpr + 1, end,
+          "expected keyword 'then' after condition of 'elseif' statement");
     }
-    const auto &[endOfStatement, success2] = Statement(endOfLogExpr + 2, end);
+
+    const auto &[endOfStatement, success2, statement] =
+        Statement(endOfCondition + 1, end);
+    Iterator endOfBody = endOfStatement;
     if (!success2) {
-      error(begin, endOfStatement, "expected statement in 'if' body");
-      exit(1);
+      endOfBody =
+          Recover(endOfStatement, end, "expected statement in 'if' body");
     }
-    const auto &[endOfAlterIfStatement, success3] =
-        AlterIfStatement(endOfStatement + 1, end);
-    return {endOfAlterIfStatement, true};
-  } else if (Else(begin)) {
-    const auto &[endOfStatement, success] = Statement(begin + 1, end);
-    if (!success) {
-      error(begin + 1, endOfStatement, "expected statement in 'else' body");
-      exit(1);
+
+    Node::Index node = ast.Add(Node::ELSEIF, at, {condition, statement});
+    first = first == Node::NONE ? node : first;
+    if (last != Node::NONE) {
+      ast.Append(last, lastAt, node);
     }
-    return {endOfStatement, true};
+    last = node;
+    lastAt = at;
+    at = endOfBody + 1;
   }
 
-  return {begin, false};
-}
+  if (!Else(at)) {
+    return {at - 1, at != begin, first};
+  }
 
-std::tuple<Iterator, bool> SyntacticParser::LogExpr(Iterator begin,
-                                                    Iterator end) {
-  const auto &[endOfLogExprInner, success] = LogExprInner(begin, end);
+  const auto &[endOfStatement, success, statement] = Statement(at + 1, end);
   if (!success) {
-    return {begin, false};
+    return {Recover(endOfStatement, end, "expected statement in 'else' body"),
+            true, first};
   }
 
-  const auto &[endOfLogExprTail, success2] =
-      LogExprTail(endOfLogExprInner + 1, end);
-  return {success2 ? endOfLogExprTail : endOfLogExprInner, true};
+  Node::Index node = ast.Add(Node::ELSE, at, {statement});
+  if (last != Node::NONE) {
+    ast.Append(last, lastAt, node);
+  }
+  return {endOfStatement, true, first == Node::NONE ? node : first};
 }
 
-std::tuple<Iterator, bool> SyntacticParser::LogExprTail(Iterator begin,
-                                                        Iterator end) {
-  if (!LogOp1(begin)) {
-    return {begin, false};
+Result SyntacticParser::LogExpr(Iterator begin, Iterator end) {
+  const auto &[endOfLogExprInner, success, left] = LogExprInner(begin, end);
+  if (!success) {
+    return {begin, false, Node::NONE};
   }
 
-  const auto &[endOfLogExprInner, success] = LogExprInner(begin + 1, end);
-  if (!success) {
-    error(begin, endOfLogExprInner,
-          "expected relation expression in logical expression");
-    exit(1);
+  const auto &[endOfLogExprTail, success2, node] =
+      LogExprTail(endOfLogExprInner + 1, end, left);
+  return {success2 ? endOfLogExprTail : endOfLogExprInner, true, node};
+}
+
+// NOTE: tails get already parsed left operand and return it unchanged if
+// there is no operator. Operators of one level are parsed in a loop, so
+// operations are left associative and long chains do not grow call stack
+Result SyntacticParser::LogExprTail(Iterator begin, Iterator end,
+                                    Node::Index left) {
+  Iterator last = begin - 1;
+
+  while (LogOp1(last + 1)) {
+    Iterator op = last + 1;
+    const auto &[endOfLogExprInner, success, right] = LogExprInner(op + 1, end);
+    if (!success) {
+      return {Recover(endOfLogExprInner, end,
+                      "expected relation expression in logical expression"),
+              true, Node::NONE};
+    }
+    left = ast.Add(Node::OR, op, {left, right});
+    last = endOfLogExprInner;
   }
-  const auto &[endOfLogExprTail, success2] =
-      LogExprTail(endOfLogExprInner + 1, end);
-  return {success2 ? endOfLogExprTail : endOfLogExprInner, true};
+
+  return {last, last != begin - 1, left};
 }
 
-std::tuple<Iterator, bool> SyntacticParser::LogExprInner(Iterator begin,
-                                                         Iterator end) {
-  const auto &[endOfRelExpr, success1] = RelExpr(begin, end);
+Result SyntacticParser::LogExprInner(Iterator begin, Iterator end) {
+  const auto &[endOfRelExpr, success1, left] = RelExpr(begin, end);
   if (!success1) {
-    return {begin, false};
+    return {begin, false, Node::NONE};
   }
 
-  const auto &[endOfLogExprInnerTail, success2] =
-      LogExprInnerTail(endOfRelExpr + 1, end);
-  return {success2 ? endOfLogExprInnerTail : endOfRelExpr, true};
+  const auto &[endOfLogExprInnerTail, success2, node] =
+      LogExprInnerTail(endOfRelExpr + 1, end, left);
+  return {success2 ? endOfLogExprInnerTail : endOfRelExpr, true, node};
 }
 
-std::tuple<Iterator, bool> SyntacticParser::LogExprInnerTail(Iterator begin,
-                                                             Iterator end) {
-  if (!LogOp2(begin)) {
-    return {begin, false};
-  }
+Result SyntacticParser::LogExprInnerTail(Iterator begin, Iterator end,
+                                         Node::Index left) {
+  Iterator last = begin - 1;
 
-  const auto &[endOfRelExpr, success] = RelExpr(begin + 1, end);
-  if (!success) {
-    error(begin, endOfRelExpr,
-          "expected relation expression in logical expression");
-    exit(1);
+  while (LogOp2(last + 1)) {
+    Iterator op = last + 1;
+    const auto &[endOfRelExpr, success, right] = RelExpr(op + 1, end);
+    if (!success) {
+      return {Recover(endOfRelExpr, end,
+                      "expected relation expression in logical expression"),
+              true, Node::NONE};
+    }
+    left = ast.Add(Node::AND, op, {left, right});
+    last = endOfRelExpr;
   }
-  const auto &[endOfLogExprInnerTail, success2] =
-      LogExprInnerTail(endOfRelExpr + 1, end);
-  return {success2 ? endOfLogExprInnerTail : endOfRelExpr, true};
+
+  return {last, last != begin - 1, left};
 }
 
-std::tuple<Iterator, bool> SyntacticParser::RelExpr(Iterator begin,
-                                                    Iterator end) {
+Result SyntacticParser::RelExpr(Iterator begin, Iterator end) {
   if (!Operand(begin)) {
-    return {begin, false};
+    return {begin, false, Node::NONE};
   }
 
   if (RelOp(begin + 1)) {
     if (!Operand(begin + 2)) {
-      error(begin, begin + 2, "expected operand in relation expression");
-      exit(1);
+      return {Recover(begin + 2, end,
+                      "expected operand in relation expression"),
+              true, Node::NONE};
     }
-    return {begin + 2, true};
+    Node::Index left = OperandNode(begin);
+    Node::Index right = OperandNode(begin + 2);
+    return {begin + 2, true,
+            ast.Add(Node::RELATION, begin + 1, {left, right})};
   }
-  return {begin, true};
+  return {begin, true, OperandNode(begin)};
 }
 
 bool SyntacticParser::RelOp(Iterator begin) {
-  return begin->type == Lexeme::Type::RELATION;
+  return tokens.Type(begin) == Lexeme::Type::RELATION;
 }
 
-std::tuple<Iterator, bool> SyntacticParser::Statement(Iterator begin,
-                                                      Iterator end) {
-  const auto &[endOfInstruction, success] = Instruction(begin, end);
+Result SyntacticParser::Statement(Iterator begin, Iterator end) {
+  const auto &[endOfInstruction, success, instruction] =
+      Instruction(begin, end);
   if (!success) {
-    return {begin, false};
+    return {begin, false, Node::NONE};
   }
 
+  Node::Index lastInstruction = instruction;
+  Iterator lastAt =
+      instruction != Node::NONE ? Ast::Token(0, ast[instruction]) : begin;
+  Node::Index statement = ast.Add(Node::STATEMENT, begin, {instruction});
+
   Iterator endOfLastInstruction = endOfInstruction;
   while (Semicolon(endOfLastInstruction + 1)) {
-    const auto &[endOfInstruction, success] =
+    const auto &[endOfInstruction, success, instruction] =
         Instruction(endOfLastInstruction + 2, end);
     if (!success) {
-      error(begin, endOfInstruction, "expected intruction after semicolon");
-      exit(1);
+      endOfLastInstruction = Recover(endOfInstruction, end,
+                                     "expected instruction after semicolon");
+      continue;
+    }
+    // NOTE: instructions skipped on errors have no nodes
+    if (instruction != Node::NONE) {
+      Node::Index &link = lastInstruction != Node::NONE
+                              ? ast[lastInstruction].next_sibling
+                              : ast[statement].first_child;
+      Iterator at = Ast::Token(0, ast[instruction]);
+      ast.Link(link, lastAt, instruction);
+      lastInstruction = instruction;
+      lastAt = at;
     }
     endOfLastInstruction = endOfInstruction;
   }
-  return {endOfLastInstruction, true};
+  return {endOfLastInstruction, true, statement};
 }
 
-std::tuple<Iterator, bool> SyntacticParser::Instruction(Iterator begin,
-                                                        Iterator end) {
+Result SyntacticParser::Instruction(Iterator begin, Iterator end) {
   if (Identifier(begin)) {
     if (AssignmentOp(begin + 1)) {
-      const auto &[endOfArithExpr, success] = ArithExpr(begin + 2, end);
+      const auto &[endOfArithExpr, success, expression] =
+          ArithExpr(begin + 2, end);
       if (!success) {
-        error(begin, endOfArithExpr,
-              "expected arithmetic expression after assignment operator");
-        exit(1);
+        Iterator endOfError = Recover(
+            endOfArithExpr, end,
+            "expected arithmetic expression after assignment operator");
+        return {endOfError, true, Node::NONE};
       }
-      return {endOfArithExpr, true};
+      Node::Index target = ast.Add(Node::IDENTIFIER, begin);
+      return {endOfArithExpr, true,
+              ast.Add(Node::ASSIGNMENT, begin + 1, {target, expression})};
     }
   } else if (InputOp(begin)) {
     if (!Identifier(begin + 1)) {
-      error(begin, begin + 1, "expected identifier after input keyword");
-      exit(1);
+      return {Recover(begin + 1, end,
+                      "expected identifier after input keyword"),
+              true, Node::NONE};
     }
-    return {begin + 1, true};
+    Node::Index target = ast.Add(Node::IDENTIFIER, begin + 1);
+    return {begin + 1, true, ast.Add(Node::INPUT, begin, {target})};
   } else if (OutputOp(begin)) {
     if (!Operand(begin + 1)) {
-      error(begin, begin + 1, "expected operand after output keyword");
-      exit(1);
+      return {Recover(begin + 1, end,
+                      "expected operand after output keyword"),
+              true, Node::NONE};
     }
-    return {begin + 1, true};
+    Node::Index operand = OperandNode(begin + 1);
+    return {begin + 1, true, ast.Add(Node::OUTPUT, begin, {operand})};
   }
 
-  return {begin, false};
+  return {begin, false, Node::NONE};
 }
 
-std::tuple<Iterator, bool> SyntacticParser::ArithExpr(Iterator begin,
-                                                      Iterator end) {
-  const auto &[endOfArithExprInner, success] = ArithExprInner(begin, end);
+Result SyntacticParser::ArithExpr(Iterator begin, Iterator end) {
+  const auto &[endOfArithExprInner, success, left] =
+      ArithExprInner(begin, end);
   if (!success) {
-    return {begin, false};
+    return {begin, false, Node::NONE};
   }
 
-  const auto &[endOfArithExprTail, success2] =
-      ArithExprTail(endOfArithExprInner + 1, end);
-  return {success2 ? endOfArithExprTail : endOfArithExprInner, true};
+  const auto &[endOfArithExprTail, success2, node] =
+      ArithExprTail(endOfArithExprInner + 1, end, left);
+  return {success2 ? endOfArithExprTail : endOfArithExprInner, true, node};
 }
 
-std::tuple<Iterator, bool> SyntacticParser::ArithExprTail(Iterator begin,
-                                                          Iterator end) {
-  if (!ArithOp1(begin)) {
-    return {begin, false};
-  }
+Result SyntacticParser::ArithExprTail(Iterator begin, Iterator end,
+                                      Node::Index left) {
+  Iterator last = begin - 1;
 
-  const auto &[endOfArithExprInner, success] = ArithExprInner(begin + 1, end);
-  if (!success) {
-    error(begin, endOfArithExprInner,
-          "expected operand in arithmetic expression");
-    exit(1);
+  while (ArithOp1(last + 1)) {
+    Iterator op = last + 1;
+    const auto &[endOfArithExprInner, success, right] =
+        ArithExprInner(op + 1, end);
+    if (!success) {
+      return {Recover(endOfArithExprInner, end,
+                      "expected operand in arithmetic expression"),
+              true, Node::NONE};
+    }
+    left = ast.Add(Node::ARITHMETIC, op, {left, right});
+    last = endOfArithExprInner;
   }
-  const auto &[endOfArithExprTail, success2] =
-      ArithExprTail(endOfArithExprInner + 1, end);
-  return {success2 ? endOfArithExprTail : endOfArithExprInner, true};
+
+  return {last, last != begin - 1, left};
 }
 
-std::tuple<Iterator, bool> SyntacticParser::ArithExprInner(Iterator begin,
-                                                           Iterator end) {
-  const auto &[endOfArithUnit, success1] = ArithUnit(begin, end);
+Result SyntacticParser::ArithExprInner(Iterator begin, Iterator end) {
+  const auto &[endOfArithUnit, success1, left] = ArithUnit(begin, end);
   if (!success1) {
-    return {begin, false};
+    return {begin, false, Node::NONE};
   }
 
-  const auto &[endOfArithExprInnerTail, success2] =
-      ArithExprInnerTail(endOfArithUnit + 1, end);
-  return {success2 ? endOfArithExprInnerTail : endOfArithUnit, true};
+  const auto &[endOfArithExprInnerTail, success2, node] =
+      ArithExprInnerTail(endOfArithUnit + 1, end, left);
+  return {success2 ? endOfArithExprInnerTail : endOfArithUnit, true, node};
 }
 
-std::tuple<Iterator, bool> SyntacticParser::ArithExprInnerTail(Iterator begin,
-                                                               Iterator end) {
-  if (!ArithOp2(begin)) {
-    return {begin, false};
-  }
+Result SyntacticParser::ArithExprInnerTail(Iterator begin, Iterator end,
+                                           Node::Index left) {
+  Iterator last = begin - 1;
 
-  const auto &[endOfArithUnit, success] = ArithUnit(begin + 1, end);
-  if (!success) {
-    error(begin, endOfArithUnit, "expected operand in arithmetic expression");
-    exit(1);
+  while (ArithOp2(last + 1)) {
+    Iterator op = last + 1;
+    const auto &[endOfArithUnit, success, right] = ArithUnit(op + 1, end);
+    if (!success) {
+      return {Recover(endOfArithUnit, end,
+                      "expected operand in arithmetic expression"),
+              true, Node::NONE};
+    }
+    left = ast.Add(Node::ARITHMETIC, op, {left, right});
+    last = endOfArithUnit;
   }
-  const auto &[endOfArithExprInnerTail, success2] =
-      ArithExprInnerTail(endOfArithUnit + 1, end);
-  return {success2 ? endOfArithExprInnerTail : endOfArithUnit, true};
+
+  return {last, last != begin - 1, left};
 }
 
-std::tuple<Iterator, bool> SyntacticParser::ArithUnit(Iterator begin,
-                                                      Iterator end) {
+Result SyntacticParser::ArithUnit(Iterator begin, Iterator end) {
   if (Operand(begin)) {
-    return {begin, true};
+    return {begin, true, OperandNode(begin)};
   }
 
   if (!OpeningParenthesis(begin)) {
-    return {begin, false};
+    return {begin, false, Node::NONE};
   }
 
-  const auto &[endOfArithExpr, success] = ArithExpr(begin + 1, end);
+  const auto &[endOfArithExpr, success, expression] =
+      ArithExpr(begin + 1, end);
   if (!success) {
-    error(begin, endOfArithExpr, "expected arithmetic expression after '(");
-    exit(1);
+    return {Recover(endOfArithExpr, end,
+                    "expected arithmetic expression after '('"),
+            true, Node::NONE};
   }
 
   if (!ClosingParenthesis(endOfArithExpr + 1)) {
-    error(begin, endOfArithExpr + 1,
-          "expected ')' after arithmetic expression");
-    exit(1);
+    return {Recover(endOfArithExpr + 1, end,
+                    "expected ')' after arithmetic expression"),
+            true, Node::NONE};
   }
 
-  return {endOfArithExpr + 1, true};
+  return {endOfArithExpr + 1, true, expression};
 }
 
 bool SyntacticParser::Operand(Iterator begin) {
   return Identifier(begin) || Constant(begin);
 }
 
+Node::Index SyntacticParser::OperandNode(Iterator begin) {
+  return ast.Add(Identifier(begin) ? Node::IDENTIFIER : Node::CONSTANT, begin);
+}
+
 bool SyntacticParser::Identifier(Iterator begin) {
-  return begin->category == Lexeme::Category::IDENTIFIER;
+  return tokens.Category(begin) == Lexeme::Category::IDENTIFIER;
 }
 
 bool SyntacticParser::Constant(Iterator begin) {
-  return begin->category == Lexeme::Category::CONSTANT;
+  return tokens.Category(begin) == Lexeme::Category::CONSTANT;
 }
 
 bool SyntacticParser::ArithOp1(Iterator begin) {
-  return begin->type == Lexeme::Type::ARITHMETIC_SIMPLE;
+  return tokens.Type(begin) == Lexeme::Type::ARITHMETIC_SIMPLE;
 }
 
 bool SyntacticParser::ArithOp2(Iterator begin) {
-  return begin->type == Lexeme::Type::ARITHMETIC_DIFICULT;
+  return tokens.Type(begin) == Lexeme::Type::ARITHMETIC_DIFICULT;
 }
 
 bool SyntacticParser::LogOp1(Iterator begin) {
-  return begin->type == Lexeme::Type::OR;
+  return tokens.Type(begin) == Lexeme::Type::OR;
 }
 
 bool SyntacticParser::LogOp2(Iterator begin) {
-  return begin->type == Lexeme::Type::AND;
+  return tokens.Type(begin) == Lexeme::Type::AND;
 }
 
 bool SyntacticParser::OpeningParenthesis(Iterator begin) {
-  return begin->type == Lexeme::Type::BRACKET && begin->value == "(";
+  return tokens.Type(begin) == Lexeme::Type::BRACKET &&
+         tokens.Value(begin) == "(";
 }
 
 bool SyntacticParser::ClosingParenthesis(Iterator begin) {
-  return begin->type == Lexeme::Type::BRACKET && begin->value == ")";
+  return tokens.Type(begin) == Lexeme::Type::BRACKET &&
+         tokens.Value(begin) == ")";
 }
 
 bool SyntacticParser::Semicolon(Iterator begin) {
-  return begin->type == Lexeme::Type::SEPARATOR;
+  return tokens.Type(begin) == Lexeme::Type::SEPARATOR;
 }
 
 bool SyntacticParser::AssignmentOp(Iterator begin) {
-  return begin->type == Lexeme::Type::ASSIGNMENT;
+  return tokens.Type(begin) == Lexeme::Type::ASSIGNMENT;
 }
 
 bool SyntacticParser::InputOp(Iterator begin) {
-  return begin->type == Lexeme::Type::INPUT;
+  return tokens.Type(begin) == Lexeme::Type::INPUT;
 }
 
 bool SyntacticParser::OutputOp(Iterator begin) {
-  return begin->type == Lexeme::Type::OUTPUT;
+  return tokens.Type(begin) == Lexeme::Type::OUTPUT;
 }
 
 bool SyntacticParser::If(Iterator begin) {
-  return begin->type == Lexeme::Type::IF;
+  return tokens.Type(begin) == Lexeme::Type::IF;
 }
 
 bool SyntacticParser::Then(Iterator begin) {
-  return begin->type == Lexeme::Type::THEN;
+  return tokens.Type(begin) == Lexeme::Type::THEN;
 }
 
 bool SyntacticParser::End(Iterator begin) {
-  return begin->type == Lexeme::Type::END;
+  return tokens.Type(begin) == Lexeme::Type::END;
 }
 
 bool SyntacticParser::ElseIf(Iterator begin) {
-  return begin->type == Lexeme::Type::ELSEIF;
+  return tokens.Type(begin) == Lexeme::Type::ELSEIF;
 }
 
 bool SyntacticParser::Else(Iterator begin) {
-  return begin->type == Lexeme::Type::ELSE;
+  return tokens.Type(begin) == Lexeme::Type::ELSE;
+}
+
+bool SyntacticParser::Synchronizing(Iterator begin) {
+  return Semicolon(begin) || End(begin) || ElseIf(begin) || Else(begin);
+}
+
+ParseResult SyntacticParser::Parse(const std::string &text) {
+  source = text;
+  return ParseSource();
 }
 
-bool SyntacticParser::Parse(const std::string &text) {
-  auto lexemes = lexer.Analyse(text);
+ParseResult SyntacticParser::ParseSource() {
+  diagnostics.clear();
+  lexer.Tokenize(source, tokens, diagnostics);
+  ast.Clear();
+  ast.Reserve(tokens.Size());
+  synchronized = tokens.Size() + 1;
 
-  auto begin = lexemes.begin();
-  auto end = lexemes.end();
-  const auto &[endOfIfStatement, success] = IfStatement(begin, end);
+  Iterator begin = 0;
+  Iterator end = tokens.Size();
+  std::size_t reported = diagnostics.size();
+  const auto &[endOfIfStatement, success, root] = IfStatement(begin, end);
+  if (!success) {
+    Report(begin, "expected 'if' statement");
+  } else if (endOfIfStatement + 1 < end && diagnostics.size() == reported) {
+    // NOTE: program is the only statement, nothing may follow its 'end'.
+    // After syntax errors the rest is mostly their consequence
+    Report(endOfIfStatement + 1, "expected end of text");
+  }
+  ast.root = root;
+  valid = diagnostics.empty();
+
+  return {valid, std::move(diagnostics)};
+}
+
+static bool Delimiter(Lexeme::Type type) {
+  return type == Lexeme::Type::SEPARATOR || type == Lexeme::Type::IF ||
+         type == Lexeme::Type::THEN || type == Lexeme::Type::ELSEIF ||
+         type == Lexeme::Type::ELSE || type == Lexeme::Type::END;
+}
+
+ParseResult SyntacticParser::Reparse(std::size_t offset, std::size_t removed,
+                                     std::string_view inserted) {
+  // NOTE: stale edit is rejected as a whole, parsed text and tree are kept
+  if (offset > source.size()) {
+    Diagnostic diagnostic = Locate(source, source.size());
+    diagnostic.message = "edit error: offset " + std::to_string(offset) +
+                         " is past the end of text";
+    return {false, {std::move(diagnostic)}};
+  }
+
+  removed = std::min(removed, source.size() - offset);
+  source.replace(offset, removed, inserted);
+
+  if (!valid) {
+    return ParseSource();
+  }
+
+  const std::ptrdiff_t shift = static_cast<std::ptrdiff_t>(inserted.size()) -
+                               static_cast<std::ptrdiff_t>(removed);
+  const std::size_t edit_end = offset + removed;
+
+  // NOTE: lexemes which end before the edit are not affected by it, since
+  // lexer never looks further than one symbol past lexeme
+  Iterator first = 0;
+  for (Iterator count = tokens.Size(); count > 0;) {
+    Iterator half = count / 2;
+    if (tokens.Offset(first + half) + tokens.Length(first + half) < offset) {
+      first += half + 1;
+      count -= half + 1;
+    } else {
+      count = half;
+    }
+  }
+
+  // NOTE: text is scanned from the first affected lexeme until a new lexeme
+  // starts where an old one past the edit did, from there on lexemes are
+  // the same. Positions are not tracked, since any lexical error leads to
+  // full parse anyway
+  TokenBuffer relexed(source);
+  std::vector<Diagnostic> errors;
+  LexicalAnalyzer::Cursor cursor;
+  cursor.offset = first < tokens.Size()
+                      ? std::min<std::size_t>(tokens.Offset(first), offset)
+                      : offset;
+  Lexeme lexeme{};
+  Iterator last = first;
+  bool resynchronized = false;
+
+  while (!resynchronized && lexer.Next(source, true, cursor, lexeme, errors)) {
+    std::ptrdiff_t at = lexeme.value.data() - source.data();
+    while (last < tokens.Size() &&
+           (tokens.Offset(last) < edit_end ||
+            static_cast<std::ptrdiff_t>(tokens.Offset(last)) + shift < at)) {
+      ++last;
+    }
+    resynchronized =
+        last < tokens.Size() &&
+        static_cast<std::ptrdiff_t>(tokens.Offset(last)) + shift == at;
+    if (!resynchronized) {
+      relexed.Append(lexeme);
+    }
+  }
+  if (!resynchronized) {
+    last = tokens.Size();
+  }
+
+  if (!errors.empty()) {
+    return ParseSource();
+  }
+  for (Iterator index = first; index < last; ++index) {
+    if (Delimiter(tokens.Type(index))) {
+      return ParseSource();
+    }
+  }
+  for (Iterator index = 0; index < relexed.Size(); ++index) {
+    if (Delimiter(relexed.Type(index))) {
+      return ParseSource();
+    }
+  }
+
+  // NOTE: edited lexemes belong to instruction which starts after ';',
+  // 'then' or 'else' and ends before ';', 'elseif', 'else' or 'end'
+  Iterator begin = first;
+  while (begin > 0 && !Delimiter(tokens.Type(begin - 1))) {
+    --begin;
+  }
+  Iterator end = last;
+  while (end < tokens.Size() && !Delimiter(tokens.Type(end))) {
+    ++end;
+  }
+
+  Lexeme::Type before = begin > 0 ? tokens.Type(begin - 1) : Lexeme::Type::IF;
+  Lexeme::Type after = tokens.Type(end);
+  if (before == Lexeme::Type::IF || before == Lexeme::Type::ELSEIF ||
+      before == Lexeme::Type::END || after == Lexeme::Type::THEN ||
+      after == Lexeme::Type::UNDEFINED) {
+    return ParseSource();
+  }
+
+  const std::ptrdiff_t tokens_shift =
+      static_cast<std::ptrdiff_t>(relexed.Size()) -
+      static_cast<std::ptrdiff_t>(last - first);
+  tokens.Splice(source, first, last, relexed, shift);
+
+  diagnostics.clear();
+  synchronized = tokens.Size() + 1;
+  const auto &[endOfInstruction, success, instruction] =
+      Instruction(begin, tokens.Size());
+  if (!success || !diagnostics.empty() ||
+      endOfInstruction + 1 != end + tokens_shift) {
+    return ParseSource();
+  }
+
+  // NOTE: tree still refers to tokens before the edit, it is searched by
+  // them
+  Iterator at = 0;
+  Node::Index *link = InstructionLink(begin, end, tokens_shift, at);
+  if (!link) {
+    return ParseSource();
+  }
+
+  Node::Index replaced = *link;
+  Node::Index next = ast[replaced].next_sibling;
+  if (next != Node::NONE) {
+    ast[next].token = static_cast<std::int32_t>(
+        Ast::Token(Ast::Token(at, ast[replaced]), ast[next]) + tokens_shift);
+    ast.Link(ast[instruction].next_sibling, Ast::Token(0, ast[instruction]),
+             next);
+  }
+  ast.Link(*link, at, instruction);
+
+  // NOTE: nodes of replaced instructions stay in arena, once they outnumber
+  // the live ones tree is built again. Full parse is then paid for by edits
+  // which replaced at least as many nodes
+  ast.Release(replaced);
+  if (2 * ast.Released() > ast.Size()) {
+    return ParseSource();
+  }
+
+  return {true, {}};
+}
+
+// NOTE: link (first child or next sibling) pointing to instruction whose
+// token lies in [begin, end), and absolute token `at` of node which owns the
+// link. Children are listed in text order, so search descends into the last
+// branch or statement starting not after `begin`. Node which follows it in
+// its list lies past the edit and is shifted by `shift` tokens, nodes after
+// that one are relative to it
+Node::Index *SyntacticParser::InstructionLink(Iterator begin, Iterator end,
+                                              std::ptrdiff_t shift,
+                                              Iterator &at) {
+  Node::Index *link = &ast.root;
+  at = 0;
+
+  while (*link != Node::NONE) {
+    Node::Index *inner = nullptr;
+    Iterator innerAt = 0;
+
+    for (Iterator position = at; *link != Node::NONE;
+         link = &ast[*link].next_sibling) {
+      Iterator token = Ast::Token(position, ast[*link]);
+      if (token >= end) {
+        break;
+      }
+
+      switch (ast[*link].kind) {
+      case Node::ASSIGNMENT:
+      case Node::INPUT:
+      case Node::OUTPUT:
+        if (begin <= token) {
+          at = position;
+          return link;
+        }
+        break;
+      case Node::IF:
+      case Node::ELSEIF:
+      case Node::ELSE:
+      case Node::STATEMENT:
+        if (token <= begin) {
+          inner = link;
+          innerAt = position;
+        }
+        break;
+      default:
+        break;
+      }
+      position = token;
+    }
+
+    if (!inner) {
+      return nullptr;
+    }
+    Node &node = ast[*inner];
+    if (node.next_sibling != Node::NONE) {
+      ast[node.next_sibling].token += static_cast<std::int32_t>(shift);
+    }
+    at = Ast::Token(innerAt, node);
+    link = &node.first_child;
+  }
 
-  return success;
+  return nullptr;
 }
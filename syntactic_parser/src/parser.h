@@ -1,38 +1,67 @@
 #pragma once
 
 #include "../../lexical_analyzer/src/analyzer.h"
+#include "ast.h"
+
+#include <tuple>
+
+// NOTE: program is correct only if there are no diagnostics, lexical ones
+// come first
+struct ParseResult {
+  bool success = false;
+  std::vector<Diagnostic> diagnostics;
+};
 
 class SyntacticParser {
 public:
-  bool Parse(const std::string &text);
+  using Iterator = TokenBuffer::Index;
+  // NOTE: last token of parsed construction, success and its node
+  using Result = std::tuple<Iterator, bool, Node::Index>;
+
+  auto Parse(const std::string &text) -> ParseResult;
+  // NOTE: replaces `removed` symbols of parsed text at `offset` by
+  // `inserted` one. Only the changed lexemes are scanned again, and if they
+  // lie inside one instruction of a correct program, only it is parsed again;
+  // any other edit is handled by full Parse. Edit at `offset` past the end
+  // of text fails and leaves parser as it was.
+  // Incremental edit costs the relexed lexemes, the reparsed instruction,
+  // and a walk down the 'elseif' chain and along the statement holding the
+  // instruction. Text and token buffer are still spliced in place, which
+  // moves their tails: time linear in program size, but a plain copy. Memory
+  // stays linear too, replaced nodes are reclaimed by full parse once they
+  // outnumber the live ones
+  auto Reparse(std::size_t offset, std::size_t removed,
+               std::string_view inserted) -> ParseResult;
 
 private:
-  using Iterator = std::vector<Lexeme>::iterator;
-  auto IfStatement(Iterator begin, Iterator end) -> std::tuple<Iterator, bool>;
-  auto AlterIfStatement(Iterator begin,
-                        Iterator end) -> std::tuple<Iterator, bool>;
-  auto LogExpr(Iterator begin, Iterator end) -> std::tuple<Iterator, bool>;
-  auto LogExprTail(Iterator begin, Iterator end) -> std::tuple<Iterator, bool>;
-  auto LogExprInner(Iterator begin, Iterator end) -> std::tuple<Iterator, bool>;
-  auto LogExprInnerTail(Iterator begin,
-                        Iterator end) -> std::tuple<Iterator, bool>;
-  auto RelExpr(Iterator begin, Iterator end) -> std::tuple<Iterator, bool>;
+  auto ParseSource() -> ParseResult;
+  auto InstructionLink(Iterator begin, Iterator end, std::ptrdiff_t shift,
+                       Iterator &at) -> Node::Index *;
+  auto Recover(Iterator at, Iterator end, const char *reason) -> Iterator;
+  void Report(Iterator at, const char *reason);
+  auto IfStatement(Iterator begin, Iterator end) -> Result;
+  auto AlterIfStatement(Iterator begin, Iterator end) -> Result;
+  auto LogExpr(Iterator begin, Iterator end) -> Result;
+  auto LogExprTail(Iterator begin, Iterator end, Node::Index left) -> Result;
+  auto LogExprInner(Iterator begin, Iterator end) -> Result;
+  auto LogExprInnerTail(Iterator begin, Iterator end,
+                        Node::Index left) -> Result;
+  auto RelExpr(Iterator begin, Iterator end) -> Result;
   auto RelOp(Iterator begin) -> bool;
-  auto Statement(Iterator begin, Iterator end) -> std::tuple<Iterator, bool>;
-  auto Instruction(Iterator begin, Iterator end) -> std::tuple<Iterator, bool>;
-  auto ArithExpr(Iterator begin, Iterator end) -> std::tuple<Iterator, bool>;
-  auto ArithExprTail(Iterator begin,
-                     Iterator end) -> std::tuple<Iterator, bool>;
-  auto ArithExprInner(Iterator begin,
-                      Iterator end) -> std::tuple<Iterator, bool>;
-  auto ArithExprInnerTail(Iterator begin,
-                          Iterator end) -> std::tuple<Iterator, bool>;
-  auto ArithUnit(Iterator begin, Iterator end) -> std::tuple<Iterator, bool>;
+  auto Statement(Iterator begin, Iterator end) -> Result;
+  auto Instruction(Iterator begin, Iterator end) -> Result;
+  auto ArithExpr(Iterator begin, Iterator end) -> Result;
+  auto ArithExprTail(Iterator begin, Iterator end, Node::Index left) -> Result;
+  auto ArithExprInner(Iterator begin, Iterator end) -> Result;
+  auto ArithExprInnerTail(Iterator begin, Iterator end,
+                          Node::Index left) -> Result;
+  auto ArithUnit(Iterator begin, Iterator end) -> Result;
   auto ArithOp1(Iterator begin) -> bool;
   auto ArithOp2(Iterator begin) -> bool;
   auto LogOp1(Iterator begin) -> bool;
   auto LogOp2(Iterator begin) -> bool;
   auto Operand(Iterator begin) -> bool;
+  auto OperandNode(Iterator begin) -> Node::Index;
   auto Identifier(Iterator begin) -> bool;
   auto Constant(Iterator begin) -> bool;
   auto OpeningParenthesis(Iterator begin) -> bool;
@@ -46,7 +75,18 @@ private:
   auto End(Iterator begin) -> bool;
   auto ElseIf(Iterator begin) -> bool;
   auto Else(Iterator begin) -> bool;
+  auto Synchronizing(Iterator begin) -> bool;
 
 public:
   LexicalAnalyzer lexer;
+  // NOTE: tokens and tree refer to this copy of parsed text
+  std::string source;
+  TokenBuffer tokens;
+  Ast ast;
+  std::vector<Diagnostic> diagnostics;
+  // NOTE: token on which parser resumed after the last error
+  Iterator synchronized;
+  // NOTE: whether source is correct program, only then it is reparsed
+  // incrementally
+  bool valid = false;
 };
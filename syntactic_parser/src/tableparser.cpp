@@ -0,0 +1,32 @@
+#include "tableparser.h"
+
+void TableParser::Report(const Mismatch &mismatch) {
+  // NOTE: erroneous lexemes are already reported by lexer
+  if (tokens.Type(mismatch.token) == Lexeme::Type::ERROR) {
+    return;
+  }
+
+  bool is_token = mismatch.token < tokens.Size();
+  Diagnostic diagnostic =
+      Locate(source, is_token ? tokens.Offset(mismatch.token) : source.size());
+  diagnostic.message =
+      "syntax error: expected " + Expected(mismatch.expected) +
+      (is_token ? " near '" + std::string(tokens.Value(mismatch.token)) + "'"
+                : std::string(" at the end of text"));
+  diagnostics.push_back(std::move(diagnostic));
+}
+
+ParseResult TableParser::Parse(std::string_view text) {
+  source.assign(text);
+  diagnostics.clear();
+  lexer.Tokenize(source, tokens, diagnostics);
+
+  // NOTE: grammar actions are of no use for recognition
+  auto mismatch =
+      driver.Parse(tokens, [](language::Action, TokenBuffer::Index) {});
+  if (mismatch) {
+    Report(*mismatch);
+  }
+
+  return {diagnostics.empty(), std::move(diagnostics)};
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "../../parser_generator/src/ll1.h"
+#include "parser.h"
+
+// NOTE: recognizer driven by LL(1) table generated from
+// parser_generator/grammars/language.ll1. Unlike SyntacticParser it builds
+// no tree and stops at the first error, but its nesting is not limited by
+// call stack
+class TableParser {
+public:
+  auto Parse(std::string_view text) -> ParseResult;
+
+private:
+  void Report(const Mismatch &mismatch);
+
+public:
+  LexicalAnalyzer lexer;
+  // NOTE: tokens refer to this copy of parsed text
+  std::string source;
+  TokenBuffer tokens;
+  std::vector<Diagnostic> diagnostics;
+
+private:
+  LL1Parser driver;
+};